@@ -1803,6 +1803,10 @@ namespace netxs::ansi
                             }
                             ++head;
                         }
+                        if (view{ base, delm } == osc_clipboard && oscer.contains(osc_clipboard)) // Let the clipboard data stream through. The terminal decodes it incrementally.
+                        {
+                            exec(0);
+                        }
                         return; // Drop bcuz no ST in the sequence.
                     }
                     else if (c == c0_bel)
@@ -2102,6 +2106,16 @@ namespace netxs::ansi
                       || c == '^'  // PM  ESC ^ ... ST
                       || c == '_') // APC ESC _ ... ST
                 {
+                    if (c == 'P') // Let the Sixel data (DCS Pn;Pn;Pn q ...) stream through. The terminal decodes it incrementally.
+                    {
+                        auto iter = next;
+                        while (++iter != tail && ((*iter >= '0' && *iter <= '9') || *iter == ';'))
+                        { }
+                        if (iter != tail && *iter == 'q')
+                        {
+                            return utf8;
+                        }
+                    }
                     while (++next != tail) // Looking for BEL.
                     {
                         auto cmd = *next;
@@ -2141,6 +2155,10 @@ namespace netxs::ansi
                             utf::purify(utf8);
                             return utf8;
                         }
+                        else if (view{ step, tail }.starts_with("52;")) // Let the clipboard data (OSC 52 ; Pc ; Pd ...) stream through. The terminal decodes it incrementally.
+                        {
+                            return utf8;
+                        }
                     }
                     while (++next != tail) // Looking for BEL.
                     {
@@ -978,11 +978,22 @@ namespace netxs::app::shared
         }
     };
 
+    static auto get_vtmode(settings& config)
+    {
+        auto vtmode = os::dtvt::vtmode;
+        if (vtmode & ui::console::direct && config.settings::take("/config/desktop/compression", faux))
+        {
+            vtmode |= ui::console::packed; // The DirectVT host decodes packed frames.
+        }
+        return vtmode;
+    }
     static auto get_gui_config(settings& config)
     {
         os::dtvt::wheelrate = config.settings::take("/config/timings/wheelrate", 3);
         auto gui_config = gui::cfg_t{ .win_state    = config.settings::take("/config/gui/winstate", winstate::normal, app::shared::win::options),
                                       .antialiasing = config.settings::take("/config/gui/antialiasing", faux),
+                                      .glyph_cache  = config.settings::take("/config/gui/glyphcache", si32{ 64 }),
+                                      .debug_logs   = config.settings::take("/config/debug/logs", faux),
                                       .blink_rate   = config.settings::take("/config/gui/blinkrate", span{ 400ms }),
                                       .wincoord     = config.settings::take("/config/gui/wincoor", dot_mx),
                                       .gridsize     = config.settings::take("/config/gui/gridsize", dot_mx),
@@ -1029,6 +1040,7 @@ namespace netxs::app::shared
         using namespace std::chrono;
         os::dtvt::wheelrate = config.settings::take("/config/timings/wheelrate"              , 3);
         g.jpeg_quality      = config.settings::take("/config/gui/quality"                    , 80);
+        g.raw_pixels        = config.settings::take("/config/gui/rawpixels"                  , faux);
         g.window_clr        = config.settings::take("/config/colors/window"                  , cell{ whitespace });
         g.winfocus          = config.settings::take("/config/colors/focus"                   , cell{ whitespace });
         g.brighter          = config.settings::take("/config/colors/brighter"                , cell{ whitespace });
@@ -1198,7 +1210,7 @@ namespace netxs::app::shared
         {
             os::dtvt::flagsz.wait(faux); // Sync with gui window. Waiting for os::dtvt::gridsz update.
         }
-        auto gate_ptr = ui::gate::ctor(server, os::dtvt::vtmode);
+        auto gate_ptr = ui::gate::ctor(server, app::shared::get_vtmode(config));
         auto& gate = *gate_ptr;
         gate.base::resize(os::dtvt::gridsz);
         gate.base::signal(tier::general, e2::config::fps, ui::skin::globals().maxfps);
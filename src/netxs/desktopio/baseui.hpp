@@ -72,6 +72,11 @@ namespace netxs
         static constexpr auto warpwindow      = __COUNTER__ - _counter;
         static constexpr auto accesslock      = __COUNTER__ - _counter;
     };
+    struct hitpoint
+    {
+        twod coor{}; // hitpoint: Point in world coordinates.
+        id_t id{}; // hitpoint: Window found at the point.
+    };
     struct winstate
     {
         static constexpr auto _counter   = __COUNTER__ + 1;
@@ -174,6 +179,8 @@ namespace netxs::events::userland
                 EVENT_XS( fps    , si32     ), // Request to set new fps, arg: new fps (si32); the value == -1 is used to request current fps.
                 GROUP_XS( cursor , span     ), // Any kind of intervals property.
                 GROUP_XS( plugins, si32     ),
+                EVENT_XS( memstat, si64     ), // preview: The process-wide accounted memory size has changed, arg: accounted bytes.
+                EVENT_XS( memtrim, si64     ), // release: Release up to the specified number of bytes of idle memory (the oldest scrollback lines first).
 
                 SUBSET_XS( cursor )
                 {
@@ -295,6 +302,7 @@ namespace netxs::events::userland
                     EVENT_XS( expose  , rect        ), // Order to bring the requested item on top of the visual tree.
                     EVENT_XS( appear  , twod        ), // Fly to the specified coords.
                     EVENT_XS( swarp   , const dent  ), // preview: Do form swarping.
+                    EVENT_XS( hittest , hitpoint    ), // request: Find the window uncovered at the world point by a window closed since the last frame.
                     GROUP_XS( go      , ui::sptr    ),
                     GROUP_XS( focus   , id_t        ),
 
@@ -682,6 +690,7 @@ namespace netxs::ui
         twod max_value = twod{ 3000, 2000 }; //todo unify
 
         si32 jpeg_quality = 80;
+        bool raw_pixels = faux;
 
         static auto& globals()
         {
@@ -1673,18 +1682,29 @@ namespace netxs::ui
             timer(base& boss) : boss{ boss } { }
 
             // pro::timer: Start countdown for specified ID.
+            //             A zero timeout means every frame tick.
             template<class P>
             void actify(id_t ID, span timeout, P lambda)
             {
-                auto alarm = datetime::now() + timeout;
-                boss.LISTEN(tier::general, e2::timer::any, now, memo[ID], (ID, timeout, lambda, alarm))
+                if (timeout == span::zero())
                 {
-                    if (now > alarm)
+                    boss.LISTEN(tier::general, e2::timer::any, now, memo[ID], (ID, lambda))
                     {
-                        alarm = now + timeout;
                         if (!lambda(ID)) pacify(ID);
+                    };
+                    return;
+                }
+                auto& alarm = memo[ID];
+                alarm = boss.indexer.make_alarm([&, ID, timeout, lambda](time& now) mutable
+                {
+                    auto self = memo[ID].get(); // Only the alarm registered under the ID can be alive.
+                    if (!lambda(ID)) pacify(ID);
+                    else if (auto iter = memo.find(ID); iter != memo.end() && iter->second.get() == self) // The lambda may have restarted the countdown.
+                    {
+                        boss.indexer.schedule(now + timeout, iter->second);
                     }
-                };
+                });
+                boss.indexer.schedule(datetime::now() + timeout, alarm);
             }
             // pro::timer: Start countdown.
             template<class P>
@@ -1411,6 +1411,38 @@ namespace netxs
             return std::nullopt;
         }
 
+        // imagens: Raw raster document: signature, LE width and height, and non-premultiplied sRGB pixels.
+        struct pixmap
+        {
+            static constexpr auto signature = "\0\0pixmap"sv; // Starts with a null to never be taken for the SVG markup.
+            static constexpr auto header = signature.size() + sizeof(ui32) * 2; // Keeps the pixels 4-byte aligned.
+
+            static auto encode(std::span<argb const> pixels, twod size)
+            {
+                auto document = text{};
+                document.reserve(header + pixels.size_bytes());
+                document += signature;
+                auto le_size = std::array{ netxs::letoh((ui32)size.x), netxs::letoh((ui32)size.y) };
+                document.append((char const*)le_size.data(), sizeof(le_size));
+                document.append((char const*)pixels.data(), pixels.size_bytes());
+                return document;
+            }
+            static auto decode(view document)
+            {
+                if (document.size() > header && document.starts_with(signature))
+                {
+                    auto size = twod{ netxs::aligned<ui32>(document.data() + signature.size()),
+                                      netxs::aligned<ui32>(document.data() + signature.size() + sizeof(ui32)) };
+                    auto count = (size_t)size.x * size.y;
+                    if (size.x > 0 && size.y > 0 && document.size() == header + count * sizeof(argb))
+                    {
+                        return std::pair{ size, std::span{ (argb const*)(document.data() + header), count }};
+                    }
+                }
+                return std::pair{ dot_00, std::span<argb const>{} };
+            }
+        };
+
         using docs = std::array<uptr<lunasvg::Document>, 3>; // Storing White/Black/Transparent variants. //todo request lunasvg to generate RGBAfp32 with A8A8
         struct image
         {
@@ -1595,7 +1627,7 @@ namespace netxs
                     }
                     if (netxs::get_bit<image::document_bit>(document_changed))
                     {
-                        changes.push_back(document);
+                        changes.push_back(view{ document }); // Referenced by the DirectVT frame builder without copying.
                     }
                     if (netxs::get_bit<image::layers_bit>(document_changed))
                     {
@@ -1728,7 +1760,7 @@ namespace netxs
                     global_attributes.push_back(ga);
                 }
                 global_attributes.push_back(sub_id);
-                global_attributes.push_back(document);
+                global_attributes.push_back(view{ document }); // Referenced by the DirectVT frame builder without copying.
                 pack_layers(global_attributes);
                 return global_attributes;
             }
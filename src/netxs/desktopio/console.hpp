@@ -23,6 +23,7 @@ namespace netxs::ui
         static constexpr auto direct  = 1 << (__COUNTER__ - _counter);
         static constexpr auto vtrgb   = 1 << (__COUNTER__ - _counter);
         static constexpr auto vt_2D   = 1 << (__COUNTER__ - _counter);
+        static constexpr auto packed  = 1 << (__COUNTER__ - _counter); // Accept packed DirectVT frames.
 
         template<class T>
         auto str(T mode)
@@ -37,6 +38,7 @@ namespace netxs::ui
                 if (mode & vtrgb  ) result += "vtrgb ";
                 if (mode & vt_2D  ) result += "vt_2D ";
                 if (mode & direct ) result += "direct ";
+                if (mode & packed ) result += "packed ";
                 if (result.size()) result.pop_back();
             }
             else result = "unknown";
@@ -52,6 +54,9 @@ namespace netxs::ui
     {
         flag active; // pipe: Is connected.
         flag isbusy; // pipe: Buffer is still busy.
+        netxs::sptr<directvt::binary::lzpack> packer; // pipe: Outgoing frames compressor.
+        std::mutex                            packmx; // pipe: Compressor mutex.
+        text                                  joined; // pipe: Compressor input buffer for gathered frames.
 
         pipe(bool active)
             : active{ active },
@@ -68,6 +73,12 @@ namespace netxs::ui
             isbusy.exchange(faux);
         }
         virtual bool send(view buff) = 0;
+        virtual bool send(std::span<view const> list) // Gather write.
+        {
+            auto block = text{};
+            for (auto crop : list) block += crop;
+            return send(block);
+        }
         virtual qiew recv(char* buff, size_t size) = 0;
         virtual qiew recv() = 0;
         virtual bool shut()
@@ -85,7 +96,25 @@ namespace netxs::ui
         virtual std::ostream& show(std::ostream& s) const = 0;
         void output(view data)
         {
-            send(data);
+            if (packer)
+            {
+                auto sync = std::lock_guard{ packmx }; // Keep the frame order in sync with the receiver dictionary.
+                auto pack = packer->encode(data);
+                send(pack.size() ? pack : data);
+            }
+            else send(data);
+        }
+        void output(std::span<view const> list)
+        {
+            if (packer)
+            {
+                auto sync = std::lock_guard{ packmx };
+                joined.clear();
+                for (auto crop : list) joined += crop;
+                auto pack = packer->encode(joined);
+                send(pack.size() ? view{ pack } : view{ joined });
+            }
+            else send(list);
         }
         friend auto& operator << (std::ostream& s, pipe const& sock)
         {
@@ -314,6 +343,10 @@ namespace netxs::ui
                 auto& path = lock.thing.path;
                 notify(e2::form::prop::cwd, path, tier::anycast);
             }
+            void handle(s11n::xs::memtrim     lock)
+            {
+                ui::memory::trim(owner.bell::indexer, lock.thing.bytes);
+            }
             void handle(s11n::xs::sysclose    lock)
             {
                 // Immediately reply (w/o queueing) on sysclose request to avoid deadlock.
@@ -346,6 +379,7 @@ namespace netxs::ui
             struct stat
             {
                 span watch{}; // diff::stat: Rendering duration.
+                span build{}; // diff::stat: Frame encoding duration.
                 sz_t delta{}; // diff::stat: Last rendered frame size.
             };
 
@@ -357,7 +391,8 @@ namespace netxs::ui
             flag  ready; // diff: Conditional variable to avoid spurious wakeup.
             flag  abort; // diff: Abort building current frame.
             work  paint; // diff: Rendering thread.
-            stat  debug; // diff: Debug info.
+            stat  debug; // diff: Debug info (guarded by the mutex).
+            stat  shown; // diff: Debug info snapshot taken by the committer.
 
             // diff: Render current buffer.
             template<class Bitmap>
@@ -375,6 +410,7 @@ namespace netxs::ui
                     auto winid = id_t{ 0xddccbbaa };
                     auto coord = dot_00;
                     image.set(winid, coord, cache, abort, debug.delta);
+                    debug.build = datetime::now() - start;
                     if (debug.delta)
                     {
                         guard.unlock(); // Allow to abort.
@@ -387,10 +423,10 @@ namespace netxs::ui
                 }
                 if constexpr (debugmode) log(prompt::diff, "Rendering thread ended", ' ', utf::to_hex_0x(std::this_thread::get_id()));
             }
-            // diff: Get rendering statistics.
+            // diff: Get rendering statistics of the previous frame (snapshot taken on the last successful send).
             auto status()
             {
-                return debug;
+                return shown;
             }
             // diff: Discard current frame.
             void cancel()
@@ -407,6 +443,7 @@ namespace netxs::ui
                         auto lock = std::unique_lock{ mutex, std::try_to_lock };
                         if (lock.owns_lock())
                         {
+                            shown = debug;
                             cache = canvas;
                             ready = true;
                             synch.notify_one();
@@ -420,6 +457,7 @@ namespace netxs::ui
                     auto lock = std::unique_lock{ mutex, std::try_to_lock };
                     if (lock.owns_lock())
                     {
+                        shown = debug;
                         cache = canvas;
                         ready = true;
                         synch.notify_one();
@@ -470,6 +508,28 @@ namespace netxs::ui
             }
         };
 
+        // gate: Adaptive frame pacing.
+        struct pacer_t
+        {
+            static constexpr auto slowest = span{ 250ms }; // pacer: The longest frame interval for slow links.
+
+            span spent{}; // pacer: Smoothed frame cost (encoding and delivery).
+            span delay{}; // pacer: Current minimal interval between frames.
+            time stamp{}; // pacer: The moment the last frame was submitted.
+
+            // pacer: Account the cost of the last delivered frame.
+            void update(span cost)
+            {
+                spent = spent == span::zero() ? cost : (spent * 7 + cost) / 8;
+                delay = std::min(spent + spent / 4, slowest); // Keep some headroom for the link to drain.
+            }
+            // pacer: Check if it is too early for the next frame.
+            bool hold(time now) const
+            {
+                return now - stamp < delay;
+            }
+        };
+
         // gate: Application properties.
         struct props_t
         {
@@ -491,6 +551,7 @@ namespace netxs::ui
             cell tooltip_colors; // conf: Tooltip rendering colors.
             bool tooltip_enabled; // conf: Enable tooltips.
             bool debug_overlay; // conf: Enable to show debug overlay.
+            bool frame_pacing; // conf: Adapt the frame rate to the client link.
             bool show_regions; // conf: Highlight region ownership.
             bool simple; // conf: .
             svga vtmode; // conf: .
@@ -510,6 +571,7 @@ namespace netxs::ui
                 tooltip_timeout   = config.settings::take("/config/tooltips/timeout"         , span{ 2000ms });
                 tooltip_enabled   = config.settings::take("/config/tooltips/enabled"         , true);
                 debug_overlay     = config.settings::take("/config/debug/overlay"            , faux);
+                frame_pacing      = config.settings::take("/config/timings/pacing"           , true);
                 show_regions      = config.settings::take("/config/debug/regions"            , faux);
                 clip_preview_glow = std::clamp(clip_preview_glow, 0, 5);
             }
@@ -561,6 +623,7 @@ namespace netxs::ui
         pipe&      canal; // gate: Channel to outside.
         props_t    props; // gate: Input gate properties.
         diff       paint; // gate: Renderer.
+        pacer_t    pacer; // gate: Frame pacing state.
         link       conio; // gate: Input data parser.
         flag       alive; // gate: sysclose isn't sent.
         bool       direct; // gate: .
@@ -569,6 +632,9 @@ namespace netxs::ui
         face       canvas; // gate: .
         std::map<si32, ui::page> gate_overlays; // gate: User defined overlays (for Lua scripting output).
         std::unordered_map<id_t, netxs::sptr<hids>> gears; // gate: .
+        std::unordered_map<id_t, input::sysmouse> motion; // gate: Coalesced motion-only mouse reports awaiting the next frame (by ext gear id).
+        si64       mouse_received; // gate: Mouse reports received from the console.
+        si64       mouse_dispatched; // gate: Mouse reports dispatched to the gears.
         pro::debug& debug;
         input::multihome_t& multihome;
 
@@ -795,14 +861,90 @@ namespace netxs::ui
             return result;
         }
 
+        // gate: Dispatch the mouse report to the gear.
+        void dispatch(input::sysmouse& m)
+        {
+            mouse_dispatched++;
+            forward(m);
+        }
+        // gate: Dispatch the pending motion of the specified gear.
+        void flush_motion(id_t ext_gear_id)
+        {
+            if (auto iter = motion.find(ext_gear_id); iter != motion.end())
+            {
+                auto m = iter->second;
+                motion.erase(iter);
+                dispatch(m);
+            }
+        }
+        // gate: Dispatch the pending motion of all gears (once per frame).
+        void flush_motion()
+        {
+            while (motion.size())
+            {
+                flush_motion(motion.begin()->first);
+            }
+        }
+        // gate: Coalesce consecutive motion-only mouse reports. Button and modifier changes are dispatched immediately (after the pending motion).
+        void enqueue_mouse(input::sysmouse& m)
+        {
+            mouse_received++;
+            auto gear_it = gears.find(m.gear_id);
+            if (gear_it == gears.end()) // The gear is created on the first report.
+            {
+                dispatch(m);
+                return;
+            }
+            auto& gear = *(gear_it->second);
+            auto iter = motion.find(m.gear_id);
+            auto& base = iter != motion.end() ? iter->second : gear.m_sys;
+            auto motion_only = m.buttons == base.buttons && m.ctlstat == base.ctlstat;
+            if (!motion_only)
+            {
+                flush_motion(m.gear_id);
+                dispatch(m);
+            }
+            else if (iter == motion.end())
+            {
+                motion.emplace(m.gear_id, m);
+            }
+            else
+            {
+                auto& pending = iter->second;
+                if (m.wheelfp && pending.wheelfp && m.hzwheel != pending.hzwheel) // Do not mix scroll axes.
+                {
+                    flush_motion(m.gear_id);
+                    motion.emplace(m.gear_id, m);
+                }
+                else
+                {
+                    if (m.wheelfp)
+                    {
+                        pending.hzwheel = m.hzwheel;
+                        pending.wheelfp += m.wheelfp;
+                        pending.wheelsi += m.wheelsi;
+                    }
+                    pending.coordxy = m.coordxy;
+                    pending.timecod = m.timecod;
+                    pending.changed = m.changed;
+                }
+            }
+        }
+
         // gate: .
         void rebuild_scene(time stamp)
         {
+            flush_motion();
             auto damaged = base::ruined();
             if (props.tooltip_enabled)
             {
                 damaged |= check_tooltips(stamp);
             }
+            if (damaged && props.frame_pacing && pacer.hold(stamp)) // Let the slow link drain before the next frame.
+            {
+                base::ruined(true);
+                return;
+            }
             if (damaged)
             {
                 if (auto context2D = canvas.change_basis(base::area()))
@@ -877,13 +1019,20 @@ namespace netxs::ui
                 if (yield) return;
             }
             yield = paint.send(canvas); // Try to output updated canvas if paint is not busy.
+            if (yield)
+            {
+                pacer.stamp = stamp;
+                if (props.frame_pacing) pacer.update(paint.status().watch); // The previous frame has been delivered.
+            }
 
             if (props.debug_overlay) // Get rendering stats.
             {
+                debug.update(mouse_received, mouse_dispatched);
                 if (yield)
                 {
                     auto d = paint.status();
                     debug.update(d.watch, d.delta);
+                    debug.update(d.build, pacer.delay, props.frame_pacing);
                 }
                 debug.update(stamp);
             }
@@ -927,11 +1076,17 @@ namespace netxs::ui
               direct{ !!(vtmode & (ui::console::direct | ui::console::gui)) },
               yield{ faux },
               fullscreen{ faux },
+              mouse_received{ 0 },
+              mouse_dispatched{ 0 },
               debug{ base::plugin<pro::debug>() },
               multihome{ base::property<input::multihome_t>("multihome") }
         {
             base::plugin<pro::focus>();
             base::plugin<pro::keybd>();
+            if (vtmode & ui::console::packed && props.vtmode == svga::dtvt)
+            {
+                canal.packer = ptr::shared<directvt::binary::lzpack>();
+            }
             auto& luafx = bell::indexer.luafx;
             auto& config = bell::indexer.config;
             auto gate_context = config.settings::push_context("/config/events/gate/");
@@ -1141,6 +1296,7 @@ namespace netxs::ui
             {
                 if (m.enabled != hids::stat::ok)
                 {
+                    flush_motion(m.gear_id);
                     auto gear_it = gears.find(m.gear_id);
                     if (gear_it != gears.end())
                     {
@@ -1153,10 +1309,11 @@ namespace netxs::ui
                     }
                     base::strike();
                 }
-                else forward(m);
+                else enqueue_mouse(m);
             };
             LISTEN(tier::release, e2::conio::keybd, k)
             {
+                flush_motion(k.gear_id); // Keep the pointer position consistent with the keystroke.
                 forward(k);
             };
             LISTEN(tier::release, e2::conio::focus::any, f)
@@ -1374,6 +1531,11 @@ namespace netxs::ui
                 {
                     conio.s11n::cwd.send(canal, path);
                 };
+                LISTEN(tier::preview, e2::config::memstat, bytes)
+                {
+                    auto [total, spare, stamp] = ui::memory::total();
+                    conio.s11n::memstat.send(canal, total, spare, datetime::now() - stamp); // Send the idle time since clocks may differ between hosts.
+                };
                 on(tier::mousepreview, input::key::MouseClick, [&](hids& /*gear*/)
                 {
                     conio.s11n::expose.send(canal);
@@ -22,6 +22,11 @@ struct consrv
     virtual void reset() = 0;
     virtual fd_t watch() = 0;
     virtual bool send(view utf8) = 0;
+    bool send(std::span<view const> list)
+    {
+        for (auto utf8 : list) if (!send(utf8)) return faux;
+        return true;
+    }
     virtual void keybd(input::hids& gear, bool decckm) = 0;
     virtual void mouse(input::hids& gear, bool moved, fp2d coord, input::mouse::prot encod, input::mouse::mode state) = 0;
     virtual void paste(view block) = 0;
@@ -5117,6 +5122,11 @@ struct consrv : ipc::stdcon
 {
     std::thread stdinput{};
     pidt        group_id{};
+    #if defined(__linux__)
+    std::mutex              readmtx{}; // consrv: Reactor reading state access.
+    std::condition_variable readsyn{}; // consrv: Reactor reading completion.
+    bool                    reading{}; // consrv: Pty master is watched by the reactor or the trailer is still running.
+    #endif
 
     template<class Term>
     consrv(Term&)
@@ -5128,6 +5138,13 @@ struct consrv : ipc::stdcon
     }
     void cleanup(bool io_log)
     {
+        #if defined(__linux__)
+        {
+            auto guard = std::unique_lock{ readmtx };
+            if (reading && io_log) log(prompt::vtty, "Waiting for reactor reading to complete");
+            readsyn.wait(guard, [&]{ return !reading; });
+        }
+        #endif
         if (stdinput.joinable())
         {
             if (io_log) log(prompt::vtty, "Reading thread joining", ' ', utf::to_hex_0x(stdinput.get_id()));
@@ -5173,11 +5190,50 @@ struct consrv : ipc::stdcon
         auto rc1 = os::syscall{ ::grantpt(fdm.value)              }; // Grant master TTY file access.
         auto rc2 = os::syscall{ ::unlockpt(fdm.value)             }; // Unlock master TTY.
         stdcon::start(fdm.value);
-        stdinput = std::thread{ [&, trailer]
+        auto reader = [&, trailer]
         {
             read_socket_thread(terminal);
             trailer();
-        }};
+        };
+        #if defined(__linux__)
+        {
+            auto guard = std::lock_guard{ readmtx };
+            reading = true;
+        }
+        auto flow = ptr::shared<text>();
+        auto done = [&, trailer]
+        {
+            trailer(); // Waitpid may block for a while, so keep it off the reactor thread.
+            auto guard = std::lock_guard{ readmtx };
+            reading = faux;
+            readsyn.notify_all();
+        };
+        auto proc = [&, flow, done](qiew shot)
+        {
+            if (shot && alive())
+            {
+                *flow += shot;
+                auto crop = ansi::purify(*flow);
+                terminal.ondata(crop);
+                flow->erase(0, crop.size()); // Delete processed data.
+                return true;
+            }
+            else if (shot) return faux; // Reactor will call us back with EOF.
+            if (terminal.io_log) log(prompt::vtty, "Reactor reading ended");
+            std::thread{ done }.detach();
+            return faux;
+        };
+        if (terminal.io_log) log(prompt::vtty, "Reactor reading started");
+        if (!os::reactor::watch(fdm.value, proc)) // Fall back to the dedicated reading thread.
+        {
+            if (terminal.io_log) log(prompt::vtty, "Reactor is unavailable");
+            auto guard = std::lock_guard{ readmtx };
+            reading = faux;
+            stdinput = std::thread{ reader };
+        }
+        #else
+        stdinput = std::thread{ reader };
+        #endif
         auto pid = os::syscall{ os::process::sysfork() };
         if (pid.value == 0) // Child branch.
         {
@@ -75,6 +75,29 @@ namespace netxs
         log("", crop);
         return 0;
     }
+    si32 luna::vtmlua_scriptstats(lua_State* lua)
+    {
+        return luna::vtmlua_run_with_indexer(lua, [&](auth& indexer)
+        {
+            auto& luafx = indexer.luafx;
+            auto order = std::vector<stat_t*>{};
+            order.reserve(luafx.metrics.size());
+            for (auto& [script_body, stat] : luafx.metrics) order.push_back(&stat);
+            std::sort(order.begin(), order.end(), [](auto a, auto b){ return a->total > b->total; });
+            auto crop = utf::concat("Scripts: ", luafx.metrics.size(), ", precompiled: ", luafx.shared.size(), ", cached: ", luafx.transient.size());
+            auto limit = ::lua_gettop(lua) ? (si32)::lua_tointeger(lua, 1) : 0; // Optional number of entries to list.
+            auto count = std::min((si32)order.size(), limit > 0 ? limit : 20);
+            for (auto i = 0; i < count; i++)
+            {
+                auto& stat = *order[i];
+                auto total = std::chrono::duration_cast<std::chrono::microseconds>(stat.total).count();
+                auto peak = std::chrono::duration_cast<std::chrono::microseconds>(stat.peak).count();
+                crop += utf::concat("\n  runs: ", stat.runs, " total: ", total, "us avg: ", total / std::max<ui64>(1, stat.runs), "us peak: ", peak, "us  ", stat.label);
+            }
+            log("", crop);
+            return 0;
+        });
+    }
     si32 luna::vtmlua_call_method(lua_State* lua) // UpValue[1]: Object_ptr. UpValue[2]: Function_name.
     {
         // Stack:
@@ -398,7 +421,7 @@ namespace netxs
     }
     text luna::run(view script_body)
     {
-        auto error = ::luaL_loadbuffer(lua, script_body.data(), script_body.size(), "inlined script body")
+        auto error = !push_function(script_body, "inlined script body")
                   || ::lua_pcall(lua, 0, 1, 0);
         auto result = text{};
         if (error)
@@ -423,21 +446,10 @@ namespace netxs
         indexer.context_refs.push_back(context);
         indexer.script_param.push_back(std::ref((T&)param));
 
-        auto error = faux;
-        if (push_function_id(script_body))
-        {
-            if (::lua_rawget(lua, -2) == LUA_TFUNCTION) // It is precompiled.
-            {
-                //if constexpr (debugmode) log("It is precompiled");
-                error = ::lua_pcall(lua, 0, 0, 0);
-            }
-            else // It is not precompiled.
-            {
-                //if constexpr (debugmode) log("It is not precompiled");
-                error = ::luaL_loadbuffer(lua, script_body.data(), script_body.size(), "script body")
-                     || ::lua_pcall(lua, 0, 0, 0);
-            }
-        }
+        auto start = datetime::now();
+        auto error = !push_function(script_body, "script body")
+                  || ::lua_pcall(lua, 0, 0, 0);
+        account(script_body, datetime::now() - start);
 
         indexer.context_refs.pop_back();
         indexer.script_param.pop_back();
@@ -491,6 +503,11 @@ namespace netxs
         }
         return count;
     }
+    // Functions are keyed by the script body itself (interned by Lua), so identical script bodies share a single compiled chunk.
+    void luna::push_function_key(view script_body)
+    {
+        ::lua_pushlstring(lua, script_body.data(), script_body.size());
+    }
     bool luna::push_function_id(view script_body)
     {
         ::lua_settop(lua, 0);
@@ -498,11 +515,7 @@ namespace netxs
         ::lua_pushstring(lua, "precompiled"); // Push internal registry key 'precompiled'.
         if (::lua_gettable(lua, LUA_REGISTRYINDEX) == LUA_TTABLE) // Retrieve address of 'precompiled' and push it to the stack at -1.
         {
-            auto script_id = script_body.data();
-            auto memory_id = reinterpret_cast<char const*>(&script_id);
-            auto lua_fx_id = view{ memory_id, sizeof(script_id) };
-            //if constexpr (debugmode) log("Function id='%%'", utf::debase437(lua_fx_id));
-            ::lua_pushlstring(lua, lua_fx_id.data(), lua_fx_id.size());
+            push_function_key(script_body);
             return true;
         }
         else
@@ -512,6 +525,64 @@ namespace netxs
             return faux;
         }
     }
+    // Push the compiled script function onto the empty stack, compiling and caching it if needed. Push an error message on failure.
+    bool luna::push_function(view script_body, char const* chunk_name)
+    {
+        if (!push_function_id(script_body)) // Fallback to a one-shot compilation.
+        {
+            return ::luaL_loadbuffer(lua, script_body.data(), script_body.size(), chunk_name) == LUA_OK;
+        }
+        ::lua_pushvalue(lua, -1); // Duplicate lua_fx_id string.
+        if (::lua_rawget(lua, -3) != LUA_TFUNCTION) // It is not compiled yet.
+        {
+            ::lua_pop(lua, 1); // Pop nil after the ::lua_rawget() call.
+            if (::luaL_loadbuffer(lua, script_body.data(), script_body.size(), chunk_name) != LUA_OK)
+            {
+                return faux;
+            }
+            ::lua_pushvalue(lua, -2); // Duplicate lua_fx_id string.
+            ::lua_pushvalue(lua, -2); // Duplicate function.
+            ::lua_rawset(lua, 1); // Store the function and pop the key/value pair.
+            if (!shared.contains(script_body)) // Unreferenced functions are cached until evicted.
+            {
+                transient.emplace_back(script_body);
+                trim_functions(1);
+            }
+        }
+        ::lua_insert(lua, 1); // Move the function to the stack bottom.
+        ::lua_settop(lua, 1);
+        return true;
+    }
+    // Evict the oldest unreferenced functions from the 'precompiled' table at table_idx.
+    void luna::trim_functions(si32 table_idx)
+    {
+        while (transient.size() > cache_limit)
+        {
+            auto script_body = std::move(transient.front());
+            transient.pop_front();
+            if (!shared.contains(script_body))
+            {
+                push_function_key(script_body);
+                ::lua_pushnil(lua);
+                ::lua_rawset(lua, table_idx); // Remove rec from the table (because of nil) and pop key and val from stack.
+            }
+        }
+    }
+    void luna::account(view script_body, span elapsed)
+    {
+        auto iter = metrics.find(script_body);
+        if (iter == metrics.end())
+        {
+            if (metrics.size() >= stats_limit) return;
+            auto label = utf::get_trimmed(script_body, " \r\n\t\f");
+            label = label.substr(0, std::min(label.find('\n'), (size_t)60));
+            iter = metrics.emplace(script_body, stat_t{ .label = text{ label } }).first;
+        }
+        auto& stat = iter->second;
+        stat.runs++;
+        stat.total += elapsed;
+        stat.peak = std::max(stat.peak, elapsed);
+    }
     void luna::precompile_function(sptr<std::pair<ui64, text>>& script_body_ptr)
     {
         if (script_body_ptr)
@@ -519,34 +590,18 @@ namespace netxs
             auto& [ref_count, script_body] = *script_body_ptr;
             if (script_body.size())
             {
-                if (push_function_id(script_body))
+                if (push_function(script_body, "script"))
                 {
-                    ::lua_pushvalue(lua, -1); // Duplicate lua_fx_id string.
-                    if (::lua_rawget(lua, -3) == LUA_TFUNCTION) // It is already precompiled.
-                    {
-                        //if constexpr (debugmode) log("The script is already precompiled");
-                        ++ref_count;
-                    }
-                    else // It is not precompiled yet.
-                    {
-                        ::lua_pop(lua, 1);  // Pop nil after the ::lua_rawget() call.
-                        auto error = ::luaL_loadbuffer(lua, script_body.data(), script_body.size(), "script");
-                        if (error)
-                        {
-                            auto result = ::lua_tostring(lua, -1);
-                            log("%%script precompilation failed:\n%body%\n%msg%\n", prompt::lua, ansi::hi(ansi::add(script_body).numerate_lines(blacklt)), ansi::err(result));
-                            ::lua_pop(lua, 1);  // Pop error message from stack.
-                        }
-                        else
-                        {
-                            //if constexpr (debugmode) log("Script precompilation is done");
-                            ::lua_rawset(lua, -3);
-                            //if constexpr (debugmode) log("Add: Precompiled function counter: %%", get_table_size());
-                            ++ref_count;
-                        }
-                    }
-                    ::lua_settop(lua, 0);
+                    ++ref_count;
+                    ++shared[script_body];
+                    //if constexpr (debugmode) log("Add: Precompiled function counter: %%", shared.size());
                 }
+                else
+                {
+                    auto result = ::lua_tostring(lua, -1);
+                    log("%%script precompilation failed:\n%body%\n%msg%\n", prompt::lua, ansi::hi(ansi::add(script_body).numerate_lines(blacklt)), ansi::err(result));
+                }
+                ::lua_settop(lua, 0);
             }
         }
     }
@@ -555,13 +610,18 @@ namespace netxs
         if (script_body_ptr)
         {
             auto& [ref_count, script_body] = *script_body_ptr;
-            if (ref_count && --ref_count == 0)
+            if (ref_count)
             {
-                if (push_function_id(script_body))
+                --ref_count;
+                auto iter = shared.find(script_body);
+                if (iter != shared.end() && --(iter->second) == 0) // The last reference is gone: keep the function cached until evicted.
                 {
-                    ::lua_pushnil(lua);
-                    ::lua_rawset(lua, -3); // Remove rec from the table (because of nil) and pop key and val from stack.
-                    //if constexpr (debugmode) log("Drop: Precompiled function counter: %%", get_table_size());
+                    shared.erase(iter);
+                    if (push_function_id(script_body))
+                    {
+                        transient.push_back(script_body);
+                        trim_functions(1);
+                    }
                     ::lua_settop(lua, 0);
                 }
             }
@@ -595,6 +655,10 @@ namespace netxs
         ::lua_pushcclosure(lua, luna::vtmlua_log, 0);
         ::lua_setglobal(lua, "log");
 
+        // Set 'scriptstats' function.
+        ::lua_pushcclosure(lua, luna::vtmlua_scriptstats, 0);
+        ::lua_setglobal(lua, "scriptstats");
+
         // Set 'indexer' internal object.
         ::lua_pushstring(lua, "indexer"); // Push internal registry key 'indexer' name.
         ::lua_pushlightuserdata(lua, &indexer); // Push the 'indexer' address as a record value.
@@ -682,6 +746,7 @@ namespace netxs::events
           luafx{ *this },
           quartz{ *this },
           e2_timer_tick_id{ ui::e2::timer::tick.id },
+          e2_timer_any_id{ ui::e2::timer::any.id },
           _null_gear_sptr{ auth::create<input::hids>(*this) },
           active_gear_ref{ *_null_gear_sptr },
           anykey_event{ get_kbchord_hint(input::key::kmap::any_key) },
@@ -781,6 +846,110 @@ namespace netxs::events
 
 namespace netxs::ui
 {
+    // controls: Process-wide memory accounting and budget.
+    struct memory
+    {
+        struct item
+        {
+            wptr              owner; // item: Accounted object.
+            std::atomic<si64> bytes; // item: Accounted bytes.
+            std::atomic<si64> spare; // item: The part of the accounted bytes that can be released on request.
+            std::atomic<time> stamp; // item: Last activity time.
+
+            item(wptr owner)
+                : owner{ owner },
+                  bytes{ 0 },
+                  spare{ 0 },
+                  stamp{ datetime::now() }
+            { }
+            // item: Update the accounted size. Return true if it has grown.
+            auto update(si64 new_bytes, si64 new_spare)
+            {
+                spare = new_spare;
+                return bytes.exchange(new_bytes) < new_bytes;
+            }
+        };
+
+        std::mutex                   mutex;   // memory: Item list mutex.
+        std::list<netxs::wptr<item>> items;   // memory: Accounted objects.
+        si64                         limit{}; // memory: Memory budget in bytes (zero to disable).
+
+        static auto& state()
+        {
+            static memory _state;
+            return _state;
+        }
+        // memory: Register a new accounting entry for the object.
+        static auto attach(wptr owner_wptr)
+        {
+            auto& inst = state();
+            auto item_ptr = ptr::shared<item>(owner_wptr);
+            auto guard = std::lock_guard{ inst.mutex };
+            inst.items.remove_if([](auto& w){ return w.expired(); });
+            inst.items.push_back(item_ptr);
+            return item_ptr;
+        }
+        // memory: Return the total number of accounted bytes, the number of bytes that can be released, and the last activity time.
+        static auto total()
+        {
+            auto& inst = state();
+            auto bytes = si64{};
+            auto spare = si64{};
+            auto stamp = time{};
+            auto guard = std::lock_guard{ inst.mutex };
+            for (auto& w : inst.items) if (auto item_ptr = w.lock())
+            {
+                bytes += item_ptr->bytes;
+                spare += item_ptr->spare;
+                stamp = std::max(stamp, item_ptr->stamp.load());
+            }
+            return std::tuple{ bytes, spare, stamp };
+        }
+        // memory: Set the memory budget in bytes.
+        static void budget(si64 new_limit)
+        {
+            state().limit = std::max(si64{}, new_limit);
+        }
+        // memory: Return the memory budget in bytes.
+        static auto budget()
+        {
+            return state().limit;
+        }
+        // memory: Ask the objects to release the specified number of bytes, the longest idle first.
+        static void trim(auth& indexer, si64 excess)
+        {
+            auto& inst = state();
+            auto queue = std::vector<netxs::sptr<item>>{};
+            {
+                auto guard = std::lock_guard{ inst.mutex };
+                for (auto& w : inst.items) if (auto item_ptr = w.lock())
+                {
+                    if (item_ptr->spare > 0) queue.push_back(item_ptr);
+                }
+            }
+            std::sort(queue.begin(), queue.end(), [](auto& a, auto& b){ return a->stamp.load() < b->stamp.load(); });
+            for (auto& item_ptr : queue)
+            {
+                if (excess <= 0) break;
+                auto bytes = std::min(excess, item_ptr->spare.load());
+                excess -= bytes;
+                indexer.enqueue(item_ptr->owner, [bytes](auto& boss)
+                {
+                    boss.base::signal(tier::release, e2::config::memtrim, bytes);
+                });
+            }
+        }
+        // memory: Trim the idle objects if the budget is exceeded.
+        static void review(auth& indexer)
+        {
+            if (auto limit = budget())
+            {
+                auto [bytes, spare, stamp] = total();
+                if (bytes > limit) trim(indexer, bytes - limit);
+            }
+        }
+    };
+
     // controls: UI extensions.
     namespace pro
     {
@@ -1275,6 +1444,7 @@ namespace netxs::ui
             si32 original_form; // caret: Original cursor form.
             span step; // caret: Blink interval. span::zero() if steady.
             time next; // caret: Time of next blinking.
+            hook tick; // caret: Blink alarm.
             cell mark; // caret: Cursor brush.
 
         public:
@@ -1438,7 +1608,10 @@ namespace netxs::ui
                 if (step != span::zero())
                 {
                     live = faux;
-                    next = {};
+                    if (std::exchange(next, time{}) != time{} && tick) // Reschedule once per blink.
+                    {
+                        boss.indexer.schedule(datetime::now(), tick);
+                    }
                 }
             }
             // pro::caret: Enable cursor.
@@ -1451,15 +1624,18 @@ namespace netxs::ui
                     if (blinking)
                     {
                         live = faux;
-                        boss.LISTEN(tier::general, e2::timer::tick, timestamp, memo)
+                        next = {};
+                        tick = boss.indexer.make_alarm([&](time& timestamp)
                         {
-                            if (timestamp > next)
+                            if (timestamp >= next) // Stale alarms left by reset() are ignored.
                             {
                                 next = timestamp + step;
                                 live = !live;
                                 boss.base::deface(body);
+                                boss.indexer.schedule(next, tick);
                             }
-                        };
+                        });
+                        boss.indexer.schedule(datetime::now(), tick);
                     }
                     else
                     {
@@ -1539,6 +1715,7 @@ namespace netxs::ui
                 if (*this)
                 {
                     memo.clear();
+                    tick.reset();
                     if (done)
                     {
                         boss.base::deface(body);
@@ -2839,9 +3016,82 @@ namespace netxs::ui
             using skill::boss,
                   skill::memo;
 
+            struct layer_t
+            {
+                rect              clip; // layer_t: Blurred area.
+                si32              size; // layer_t: Blur radius.
+                std::vector<ui64> rows; // layer_t: Row digests of the area beneath.
+                std::vector<argb> blur; // layer_t: Blurred background colors.
+            };
+
+            static constexpr auto max_layers = 8_sz; // acryl: Max number of per-gate layers.
+
             si32 width; // acryl: Blur radius.
             bool alive; // acryl: Is active.
             vrgb cache; // acryl: Boxblur temp buffer.
+            std::vector<ui64> digest; // acryl: Row digests of the current frame.
+            std::unordered_map<id_t, layer_t> layers; // acryl: Last blurred result per canvas owner (user gate).
+
+            // acryl: Blur the canvas background reusing the previous result for the rows whose surroundings did not change.
+            void update(face& canvas, layer_t& layer)
+            {
+                auto area = canvas.area();
+                auto clip = canvas.clip();
+                auto w = clip.size.x;
+                auto h = clip.size.y;
+                if (w <= 0 || h <= 0 || width <= 0) return;
+                auto stride = area.size.x;
+                auto s_ptr = canvas.begin(clip.coor - area.coor);
+                digest.resize(h);
+                auto y_ptr = s_ptr;
+                for (auto& d : digest)
+                {
+                    auto hash = ui64{ 0xcbf29ce484222325 };
+                    auto x_ptr = y_ptr;
+                    auto x_end = y_ptr + w;
+                    while (x_ptr != x_end)
+                    {
+                        hash = (hash ^ x_ptr++->bgc().token) * 0x100000001b3;
+                    }
+                    d = hash;
+                    y_ptr += stride;
+                }
+                auto full = layer.clip != clip || layer.size != width || layer.rows.size() != (size_t)h;
+                auto y0 = 0;
+                auto y1 = h - 1;
+                if (!full)
+                {
+                    while (y0 < h && digest[y0] == layer.rows[y0]) y0++;
+                    while (y1 > y0 && digest[y1] == layer.rows[y1]) y1--;
+                }
+                auto reach = width * 2; // Vertical reach of the double box blur.
+                auto keep_lo = 0;
+                auto keep_hi = -1;
+                if (y0 < h) // Blur the band around the changed rows with enough context for the kept rows to be exact.
+                {
+                    auto band_lo = std::max(0, y0 - reach * 2);
+                    auto band_hi = std::min(h - 1, y1 + reach * 2);
+                    keep_lo = std::max(0, y0 - reach);
+                    keep_hi = std::min(h - 1, y1 + reach);
+                    canvas.clip({{ clip.coor.x, clip.coor.y + band_lo }, { w, band_hi - band_lo + 1 }});
+                    canvas.blur(width, cache, [](cell& c){ c.alpha(0xFF); });
+                    canvas.clip(clip);
+                    layer.blur.resize(w * h);
+                    std::swap(layer.rows, digest);
+                    layer.clip = clip;
+                    layer.size = width;
+                }
+                auto b_ptr = layer.blur.begin();
+                y_ptr = s_ptr;
+                for (auto y = 0; y < h; y++)
+                {
+                    auto x_ptr = y_ptr;
+                    auto x_end = y_ptr + w;
+                    if (y >= keep_lo && y <= keep_hi) while (x_ptr != x_end) *b_ptr++ = x_ptr++->bgc(); // Store the fresh rows.
+                    else                              while (x_ptr != x_end) x_ptr++->bgc(*b_ptr++);   // Restore the unchanged rows.
+                    y_ptr += stride;
+                }
+            }
 
         public:
             acryl(base&&) = delete;
@@ -2861,7 +3111,8 @@ namespace netxs::ui
                 boss.LISTEN(tier::release, e2::render::background::prerender, parent_canvas, memo)
                 {
                     if (!alive) return;
-                    parent_canvas.blur(width, cache, [&](cell& c){ c.alpha(0xFF); });
+                    if (layers.size() > max_layers && !layers.contains(parent_canvas.link())) layers.clear();
+                    update(parent_canvas, layers[parent_canvas.link()]);
                 };
             }
         };
@@ -3158,6 +3409,8 @@ namespace netxs::ui
             X(render_ns    , "stdout time"      ) \
             X(frame_size   , "frame size"       ) \
             X(frame_rate   , "frame rate"       ) \
+            X(frame_pace   , "frame pacing"     ) \
+            X(mem_usage    , "memory usage"     ) \
             X(focused      , "focus"            ) \
             X(win_size     , "win size"         ) \
             X(key_code     , "key virt"         ) \
@@ -3168,6 +3421,7 @@ namespace netxs::ui
             X(ctrl_state   , "controls"         ) \
             X(k            , "k"                ) \
             X(mouse_pos    , "mouse coord"      ) \
+            X(mouse_queue  , "mouse coalesced"  ) \
             X(mouse_wheelsi, "wheel steps"      ) \
             X(mouse_wheeldt, "wheel delta"      ) \
             X(mouse_hzwheel, "H wheel"          ) \
@@ -3210,6 +3464,11 @@ namespace netxs::ui
                 si32 frsize = 0;
                 si64 totals = 0;
                 si32 number = 0;    // info: Current frame number
+                span encode = span::zero(); // info: Frame encoding time.
+                span pacing = span::zero(); // info: Current frame interval (adaptive pacing).
+                bool adapts = faux; // info: Adaptive pacing is enabled.
+                si64 mouse_rx = 0;  // info: Mouse reports received.
+                si64 mouse_tx = 0;  // info: Mouse reports dispatched after coalescing.
             }
             track; // debug: Telemetry data.
 
@@ -3233,12 +3492,30 @@ namespace netxs::ui
             {
                 track.render = datetime::now() - timestamp;
             }
+            void update(span encode, span pacing, bool adapts)
+            {
+                track.encode = encode;
+                track.pacing = pacing;
+                track.adapts = adapts;
+            }
+            void update(si64 mouse_received, si64 mouse_dispatched)
+            {
+                track.mouse_rx = mouse_received;
+                track.mouse_tx = mouse_dispatched;
+            }
             void output(face& canvas)
             {
                 status[prop::render_ns] = utf::adjust(utf::format(track.output.count()), 11, " ", true) + "ns";
                 status[prop::proceed_ns] = utf::adjust(utf::format (track.render.count()), 11, " ", true) + "ns";
                 status[prop::frame_size] = utf::adjust(utf::format(track.frsize), 7, " ", true) + " bytes";
                 status[prop::total_size] = utf::format(track.totals) + " bytes";
+                status[prop::frame_pace] = !track.adapts ? "off"s
+                                                         : utf::concat(datetime::round<si32>(track.pacing), "ms (encode ", datetime::round<si32, std::chrono::microseconds>(track.encode), "us)");
+                auto [mem_bytes, mem_spare, mem_stamp] = ui::memory::total();
+                auto mem_limit = ui::memory::budget();
+                status[prop::mem_usage] = utf::concat(utf::format(mem_bytes), " bytes (", utf::format(mem_spare), " trimmable)", mem_limit ? utf::concat(" of ", utf::format(mem_limit)) : ""s);
+                auto merged = std::max(si64{}, track.mouse_rx - track.mouse_tx);
+                status[prop::mouse_queue] = utf::concat(utf::format(merged), " of ", utf::format(track.mouse_rx), " (", track.mouse_rx ? merged * 100 / track.mouse_rx : si64{}, "%)");
                 track.number++;
                 status.reindex();
                 auto ctx = canvas.change_basis(canvas.area());
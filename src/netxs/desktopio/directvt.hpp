@@ -256,15 +256,85 @@ namespace netxs::directvt
                 return valid;
             }
 
+            static constexpr auto refer_min = 4096_sz; // stream: Payloads of this size and larger are referenced instead of being copied.
+
         protected:
+            using refs = std::vector<std::pair<sz_t, view>>;
+
             escx block;
             sz_t basis;
             sz_t start;
             bool valid;
+            refs links; // stream: External payload segments: pairs of (insertion offset in block, payload).
+            sz_t extra; // stream: Total size of external payloads.
+            std::vector<view> parts; // stream: Gather list for vectored output.
 
             // stream: .
             template<class T>
-            void fuse(T&& data) { fuse_ext(block, std::forward<T>(data)); }
+            void fuse(T&& data)
+            {
+                using D = std::remove_cvref_t<T>;
+                if constexpr (std::is_same_v<D, many>) // Route std::any items through fuse() to pick up referenced payloads.
+                {
+                    fuse_ext(block, (sz_t)data.size());
+                    for (auto& item : data) fuse(item);
+                }
+                else if constexpr (std::is_same_v<D, std::any>)
+                {
+                    if (auto payload = std::any_cast<view>(&data)) // Serialized as text.
+                    {
+                        fuse_ext(block, make_ui32("text"));
+                        refer(*payload);
+                    }
+                    else fuse_ext(block, data);
+                }
+                else fuse_ext(block, std::forward<T>(data));
+            }
+            // stream: Add a length-prefixed payload by reference. The payload must stay alive until the stream is sent.
+            void refer(view payload)
+            {
+                if (payload.size() < refer_min) fuse_ext(block, payload);
+                else
+                {
+                    fuse_ext(block, (sz_t)payload.size());
+                    links.emplace_back((sz_t)block.size(), payload);
+                    extra += (sz_t)payload.size();
+                }
+            }
+            // stream: Copy referenced payloads into the block.
+            void flatten()
+            {
+                if (links.empty()) return;
+                auto head = (sz_t)block.size();
+                block.resize(head + extra);
+                auto dest = block.text::data() + block.size();
+                for (auto [at, payload] : links | std::views::reverse) // Move the tail segments apart from the end.
+                {
+                    auto tail = head - at;
+                    dest -= tail;
+                    ::memmove(dest, block.text::data() + at, tail);
+                    dest -= payload.size();
+                    ::memcpy(dest, payload.data(), payload.size());
+                    head = at;
+                }
+                links.clear();
+                extra = 0;
+            }
+            // stream: Build the gather list of the block and referenced payloads.
+            auto& gather()
+            {
+                auto data = view{ block };
+                auto from = 0_sz;
+                parts.clear();
+                for (auto [at, payload] : links)
+                {
+                    parts.push_back(data.substr(from, at - from));
+                    parts.push_back(payload);
+                    from = at;
+                }
+                parts.push_back(data.substr(from));
+                return parts;
+            }
             // stream: Replace bytes at specified position.
             template<class T>
             inline auto& add_at(sz_t at, T&& data)
@@ -567,12 +637,14 @@ namespace netxs::directvt
             // stream: .
             auto length() const
             {
-                return (sz_t)block.length();
+                return (sz_t)block.length() + extra;
             }
             // stream: .
             auto reset()
             {
                 block.resize(basis);
+                links.clear();
+                extra = 0;
                 return sz_t{ 0 };
             }
             // stream: .
@@ -603,7 +675,16 @@ namespace netxs::directvt
             {
                 if (stream::commit(Discard_empty))
                 {
-                    sender.output(block);
+                    if (links.empty()) sender.output(block);
+                    else if constexpr (requires{ sender.output(std::span<view const>{}); })
+                    {
+                        sender.output(std::span<view const>{ gather() });
+                    }
+                    else
+                    {
+                        flatten();
+                        sender.output(block);
+                    }
                     if constexpr (Move) stream::reset();
                 }
             }
@@ -618,6 +699,7 @@ namespace netxs::directvt
             {
                 if (stream::commit(Discard_empty))
                 {
+                    flatten();
                     output(block);
                     stream::reset();
                 }
@@ -675,6 +757,11 @@ namespace netxs::directvt
             void emplace(stream& other)
             {
                 other.commit();
+                for (auto [at, payload] : other.links)
+                {
+                    links.emplace_back((sz_t)block.size() + at, payload);
+                }
+                extra += other.extra;
                 block += other.block;
                 other.reset();
             }
@@ -684,7 +771,8 @@ namespace netxs::directvt
             stream(type kind)
                 : basis{ sizeof(basis) + sizeof(kind) },
                   start{ basis                        },
-                  valid{ true                         }
+                  valid{ true                         },
+                  extra{ 0                            }
             {
                 add(basis, kind);
             }
@@ -692,6 +780,170 @@ namespace netxs::directvt
             stream& operator = (stream&&) = default;
         };
 
+        // directvt: LZ77 frame compressor for slow links.
+        //           Frames are packed as a whole into a frame of the lzpack::kind. Both sides keep
+        //           the tail of the previously packed frames as a sliding dictionary, so the
+        //           repetitive cell runs of successive bitmap updates are encoded as back references.
+        struct lzpack
+        {
+            static constexpr auto kind = type{ is_list - 1 }; // lzpack: Packed frame kind (kept out of the __COUNTER__ sequence to keep the other kinds stable).
+            static constexpr auto reach = 65535_sz; // lzpack: Max back reference distance (dictionary size).
+            static constexpr auto least = 256_sz; // lzpack: Frames shorter than this are not worth packing.
+            static constexpr auto probe = 4_sz; // lzpack: Min match length.
+            static constexpr auto hbits = 14; // lzpack: Hash table size (bits).
+            static constexpr auto nopos = std::numeric_limits<ui32>::max();
+            static constexpr auto head = sizeof(sz_t) + sizeof(type) + sizeof(sz_t); // lzpack: Frame size, kind and unpacked size.
+
+            text              hist; // lzpack: Dictionary followed by the current frame.
+            text              pack; // lzpack: Packed frame buffer.
+            std::vector<ui32> hash; // lzpack: Last stream positions by hash (kept across frames, matches are verified against hist).
+            size_t            drop{}; // lzpack: Stream position of hist[0] (bytes trimmed so far).
+            size_t            next{}; // lzpack: Stream position of the first byte not hashed yet.
+
+            static auto index(char const* ptr)
+            {
+                return (netxs::aligned<ui32>(ptr) * 2654435761u) >> (32 - hbits);
+            }
+            void put_size(sz_t size)
+            {
+                auto le_size = netxs::letoh(size);
+                pack.append(reinterpret_cast<char const*>(&le_size), sizeof(le_size));
+            }
+            void put_length(size_t length)
+            {
+                for (; length >= 255; length -= 255) pack.push_back((char)255);
+                pack.push_back((char)length);
+            }
+            // lzpack: Keep the last 'reach' bytes as a dictionary for the next frame.
+            void trim()
+            {
+                if (hist.size() > reach)
+                {
+                    auto size = hist.size() - reach;
+                    hist.erase(0, size);
+                    drop += size;
+                }
+            }
+            // lzpack: Pack the frame. Return an empty view if it is not worth it.
+            view encode(view data)
+            {
+                if (data.size() < least) return {};
+                trim();
+                auto base = hist.size();
+                hist += data;
+                auto iter = hist.data();
+                auto stop = hist.size();
+                auto mark = [&](size_t i)
+                {
+                    hash[index(iter + i)] = (ui32)(drop + i);
+                };
+                if (hash.empty()) hash.assign(1 << hbits, nopos);
+                for (auto i = next > drop ? next - drop : 0_sz; i < base && i + probe <= stop; i++) // Hash the dictionary tail that could not be hashed while its frame was the last one.
+                {
+                    mark(i);
+                }
+                pack.clear();
+                pack.resize(head - sizeof(sz_t));
+                pack[sizeof(sz_t)] = (char)kind;
+                put_size((sz_t)data.size());
+                auto emit = [&](size_t from, size_t upto, size_t offset, size_t length) // Token: 4-bit literal count and 4-bit match length.
+                {
+                    auto count = upto - from;
+                    auto extra = length ? length - probe : 0;
+                    pack.push_back((char)((std::min(count, 15_sz) << 4) | std::min(extra, 15_sz)));
+                    if (count >= 15) put_length(count - 15);
+                    pack.append(iter + from, count);
+                    if (length)
+                    {
+                        pack.push_back((char)(offset & 0xFF));
+                        pack.push_back((char)(offset >> 8));
+                        if (extra >= 15) put_length(extra - 15);
+                    }
+                };
+                auto from = base;
+                auto i = base;
+                while (i + probe <= stop)
+                {
+                    auto spot = (ui32)(drop + i);
+                    auto dist = (size_t)(ui32)(spot - std::exchange(hash[index(iter + i)], spot)); // Stale and wrapped positions are rejected by the checks below.
+                    if (dist && dist <= reach && dist <= i && std::memcmp(iter + i - dist, iter + i, probe) == 0)
+                    {
+                        auto prev = i - dist;
+                        auto length = probe;
+                        while (i + length < stop && iter[prev + length] == iter[i + length]) length++;
+                        emit(from, i, dist, length);
+                        for (auto j = i + 1; j < i + length && j + probe <= stop; j++) mark(j); // Keep every dictionary position hashed for the next frames.
+                        i += length;
+                        from = i;
+                    }
+                    else i++;
+                    if (pack.size() >= data.size()) break; // Incompressible.
+                }
+                if (pack.size() < data.size() && from < stop)
+                {
+                    emit(from, stop, 0, 0);
+                }
+                if (pack.size() >= data.size())
+                {
+                    hist.resize(base); // The receiver will not see this frame packed.
+                    next = drop + base - std::min(base, probe - 1); // Rehash the dictionary tail next time.
+                    return {};
+                }
+                next = drop + i;
+                auto le_size = netxs::letoh((sz_t)pack.size());
+                ::memcpy(pack.data(), reinterpret_cast<void const*>(&le_size), sizeof(le_size));
+                return pack;
+            }
+            // lzpack: Unpack the frame payload (after the frame kind). Return an empty view on corrupted data.
+            view decode(view data)
+            {
+                if (data.size() < sizeof(sz_t)) return {};
+                auto total = (size_t)netxs::aligned<sz_t>(data.data());
+                data.remove_prefix(sizeof(sz_t));
+                trim();
+                auto base = hist.size();
+                auto stop = base + total;
+                hist.reserve(stop);
+                auto get_length = [&](size_t length)
+                {
+                    if (length == 15)
+                    {
+                        auto c = byte{ 255 };
+                        while (c == 255 && data.size())
+                        {
+                            c = (byte)data.front();
+                            data.remove_prefix(1);
+                            length += c;
+                        }
+                    }
+                    return length;
+                };
+                while (hist.size() < stop && data.size())
+                {
+                    auto token = (byte)data.front();
+                    data.remove_prefix(1);
+                    auto count = get_length(token >> 4);
+                    if (count > data.size() || hist.size() + count > stop) break;
+                    hist.append(data.data(), count);
+                    data.remove_prefix(count);
+                    if (hist.size() == stop || data.size() < 2) break;
+                    auto offset = (size_t)(byte)data[0] | ((size_t)(byte)data[1] << 8);
+                    data.remove_prefix(2);
+                    auto length = get_length(token & 0x0F) + probe;
+                    if (!offset || offset > hist.size() || hist.size() + length > stop) break;
+                    auto from = hist.size() - offset;
+                    while (length--) hist.push_back(hist[from++]); // The ranges may overlap.
+                }
+                if (hist.size() != stop)
+                {
+                    log(prompt::dtvt, "Corrupted packed frame");
+                    hist.resize(base);
+                    return {};
+                }
+                return view{ hist }.substr(base);
+            }
+        };
+
         template<class Base>
         class wrapper
         {
@@ -1075,6 +1327,8 @@ namespace netxs::directvt
         STRUCT_macro(img_element,        (ui16, index) (many, global_attributes)) // Reply image metadata list<img_element>. Access by imagens::gb::<attr_index>; The document_bits:(sub_id and document)+list_of_layers(index sub_id changed_bits attrs) is always placed at the end of the list.
         STRUCT_macro(update_img_request, (ui16, index) (si32, changed_bits) (many, changes)) // The document_bits:(sub_id and document)+list_of_layers(index sub_id changed_bits attrs) is always placed at the end of the list if set.
         STRUCT_macro(remove_img_request, (std::vector<ui16>, indexes))
+        STRUCT_macro(memstat,            (si64, bytes) (si64, spare) (span, idle))
+        STRUCT_macro(memtrim,            (si64, bytes))
 
         #undef STRUCT_macro
         #undef STRUCT_macro_lite
@@ -1976,7 +2230,9 @@ namespace netxs::directvt
             X(request_img       ) /* Request unknown images metadata.              */\
             X(unknown_img       ) /* Unknown image index.                          */\
             X(update_img_request) /* Unknown image index.                          */\
-            X(remove_img_request) /* Unknown image index.                          */
+            X(remove_img_request) /* Unknown image index.                          */\
+            X(memstat           ) /* Memory accounting notification.               */\
+            X(memtrim           ) /* Request to release idle memory.               */
             //X(quit             ) /* Close and disconnect dtvt app.                */
             //X(focus            ) /* Request to set focus.                         */
 
@@ -1996,6 +2252,7 @@ namespace netxs::directvt
             escx s11n_logpad; // s11n: Logs left margin.
             std::array<ui16, 65536> nat{}; // s11n: ext_to_int_map: Registered image indexes lookup map. nat[0] indicates local(0)/remote(1)
             std::vector<ui16>       unk; // s11n: List of unknown image indexes.
+            lzpack                  inflate; // s11n: Packed frames decoder.
 
             // s11n: Deserialize objects.
             void sync(view& data)
@@ -2003,6 +2260,13 @@ namespace netxs::directvt
                 auto lock = frames.sync(data);
                 for(auto& frame : lock.thing)
                 {
+                    if (frame.next == lzpack::kind)
+                    {
+                        auto plain = text{ inflate.decode(frame.data) }; // Copy out of the dictionary.
+                        auto crop = view{ plain };
+                        if (crop.size()) sync(crop);
+                        continue;
+                    }
                     auto iter = exec.find(frame.next);
                     if (iter != exec.end())
                     {
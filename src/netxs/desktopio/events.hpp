@@ -241,7 +241,12 @@ namespace netxs::events
         si32                                      fps{};
         hook                                      memo;
         datetime::quartz<auth>                    quartz;
+        datetime::wheel<wook>                     alarms; // auth: Sparse deadlines (see schedule()).
         hint                                      e2_timer_tick_id;
+        hint                                      e2_timer_any_id;
+        bool                                      beating{}; // auth: Someone is subscribed to the frame tick.
+        time                                      beat_due{}; // auth: The moment of the next frame tick.
+        time                                      planned{ maxtime }; // auth: The moment the timer thread is going to wake up.
         si32                                      handled{}; // auth: Last notify operation result.
         std::vector<std::pair<hint, si32>>        queue; // auth: Event queue: { event_id, call state }.
         std::vector<wptr<fxbase>>                 qcopy; // auth: Copy of the current pretenders to exec on current event.
@@ -314,6 +319,11 @@ namespace netxs::events
         {
             auto& target_reactor = Tier == tier::general ? general : reactor;
             target_reactor[event | tier_mask(Tier)].push_back(proc_ptr);
+            if (!beating && Tier == tier::general && (event == e2_timer_tick_id || event == e2_timer_any_id))
+            {
+                beating = true;
+                quartz.wake(); // Resume the frame ticking.
+            }
         }
         template<class Arg>
         auto _subscribe(si32 Tier, fmap& reactor, hint event, fx<Arg>&& proc)
@@ -449,11 +459,58 @@ namespace netxs::events
         {
             return std::unique_lock{ mutex };
         }
-        // auth: .
-        void timer(time now)
+        // auth: Check if anyone is subscribed to the frame tick.
+        bool ticking()
+        {
+            auto tiermask = tier_mask(tier::general);
+            for (auto event : { e2_timer_tick_id, e2_timer_any_id })
+            {
+                auto iter = general.find(event | tiermask);
+                if (iter != general.end())
+                {
+                    auto& fxlist = iter->second;
+                    fxlist.remove_if([](auto& f){ return f.expired(); });
+                    if (fxlist.size()) return true;
+                }
+            }
+            return faux;
+        }
+        // auth: Fire the expired alarms and the frame tick (if someone is ticking). Return the moment to be called next.
+        time timer(time now, time beat)
         {
             auto lock = sync();
-            _notify(tier::general, general, e2_timer_tick_id, now);
+            alarms.advance(now, [&](wook& alarm)
+            {
+                if (auto proc_ptr = alarm.lock())
+                {
+                    proc_ptr->call(luafx, now);
+                }
+            });
+            beating = ticking();
+            if (beating && now >= beat_due)
+            {
+                beat_due = beat;
+                _notify(tier::general, general, e2_timer_tick_id, now);
+                beating = ticking();
+            }
+            if (!beating) beat_due = {};
+            planned = beating ? std::min(beat_due, alarms.next()) : alarms.next();
+            return planned;
+        }
+        // auth: Make an alarm proc for schedule().
+        static hook make_alarm(fx<time> proc)
+        {
+            return hook{ ptr::shared<fxwrapper<time, fxbase>>(std::move(proc)) };
+        }
+        // auth: Call the proc once at the deadline (millisecond precision). Releasing the proc cancels the alarm.
+        void schedule(time deadline, hook& proc)
+        {
+            alarms.add(deadline, proc);
+            if (deadline < planned)
+            {
+                planned = deadline;
+                quartz.wake();
+            }
         }
         // auth: Delete object instance.
         template<class T>
@@ -387,6 +387,76 @@ namespace netxs::generics
         { }
     };
 
+    // generics: Random access container stored in fixed-size chunks (no large contiguous allocations, O(chunk) gap opening).
+    template<class T, si32 Bits = 12>
+    struct chunked
+    {
+        using value_type = T;
+        using item_ptr = std::unique_ptr<T[]>;
+
+        static constexpr auto chunk = si32{ 1 } << Bits; // chunked: Items per chunk.
+        static constexpr auto mask = chunk - 1;
+
+        std::vector<item_ptr> data; // chunked: Chunk directory.
+        si32                  count; // chunked: Items count.
+
+        chunked(si32 n = 0)
+            : count{ 0 }
+        {
+            resize(n);
+        }
+
+        auto size() const            { return (size_t)count;                       }
+        auto capacity() const        { return data.size() * chunk;                 }
+        auto& operator [] (si32 i)       { return data[i >> Bits][i & mask]; }
+        auto& operator [] (si32 i) const { return data[i >> Bits][i & mask]; }
+        void reserve(si32 n)         { data.reserve((n + mask) >> Bits);           }
+        template<class ...Args>
+        auto& emplace_back(Args&&... args)
+        {
+            if (count == (si32)capacity()) data.push_back(std::make_unique<T[]>(chunk));
+            auto& item = (*this)[count++];
+            item = T(std::forward<Args>(args)...);
+            return item;
+        }
+        // chunked: Resize the container. Released chunks are freed.
+        void resize(si32 n)
+        {
+            auto need = (size_t)((n + mask) >> Bits);
+            if (n < count) // Reset the dropped items in the retained tail chunk.
+            {
+                auto upto = std::min(count, (si32)(need * chunk));
+                for (auto i = n; i < upto; i++) (*this)[i] = T{};
+            }
+            data.resize(need);
+            for (auto& c : data) if (!c) c = std::make_unique<T[]>(chunk);
+            count = n;
+        }
+        // chunked: Open a gap of the specified size at the specified position by shifting the following items forward.
+        void widen(si32 at, si32 delta)
+        {
+            auto n = count;
+            if (delta % chunk == 0 && at < n) // Insert whole chunks into the directory and move the rest of the split chunk.
+            {
+                auto k = at >> Bits;
+                auto d = delta >> Bits;
+                auto fill = std::vector<item_ptr>(d);
+                for (auto& c : fill) c = std::make_unique<T[]>(chunk);
+                data.insert(data.begin() + k + 1, std::make_move_iterator(fill.begin()), std::make_move_iterator(fill.end()));
+                auto& src = data[k];
+                auto& dst = data[k + d];
+                auto last = std::min(chunk, n - (k << Bits));
+                std::move(src.get() + (at & mask), src.get() + last, dst.get() + (at & mask));
+                count += delta;
+            }
+            else
+            {
+                resize(n + delta);
+                for (auto i = n; i-- > at;) (*this)[i + delta] = std::move((*this)[i]);
+            }
+        }
+    };
+
     // generics: .
     template<class vect, bool UseUndock = faux>
     struct ring
@@ -434,7 +504,7 @@ namespace netxs::generics
             auto& operator ++ ()                    {                                        buff->inc(addr); return *this; }
             auto& operator -- ()                    {                                        buff->dec(addr); return *this; }
             auto& operator *  ()                    { return buff->buff[addr];                                              }
-            auto  operator -> ()                    { return buff->buff.begin() + addr;                                     }
+            auto  operator -> ()                    { return &buff->buff[addr];                                             }
             auto  operator != (iter const& m) const { return addr != m.addr;                                                }
             auto  operator == (iter const& m) const { return addr == m.addr;                                                }
             auto  operator -  (iter const& m) const { return (difference_type)buff->dst(m.addr, addr);                      }
@@ -476,7 +546,7 @@ namespace netxs::generics
         auto& front() const        { return buff[head];          }
         auto& current     ()       { return buff[cart];          }
         auto& operator  * ()       { return buff[cart];          }
-        auto  operator -> ()       { return buff.begin() + cart; }
+        auto  operator -> ()       { return &buff[cart];         }
         auto&          at (si32 i) { assert(i >= 0 && i < size); return buff[mod(head + i)]; }
         auto& operator [] (si32 i) { return at(i);               }
         auto  index() const        { return dst(head, cart);     }
@@ -499,7 +569,9 @@ namespace netxs::generics
             {
                 if (step && peak <= mxsz)
                 {
-                    auto new_size = (si32)std::min((ui32)size + (ui32)step, (ui32)mxsz);
+                    auto grow_by = step;
+                    if constexpr (requires{ vect::chunk; }) grow_by = (step + vect::mask) & ~vect::mask; // Grow by whole chunks.
+                    auto new_size = (si32)std::min((ui32)size + (ui32)grow_by, (ui32)mxsz);
                     resize(new_size);
                 }
                 else return true;
@@ -719,6 +791,30 @@ namespace netxs::generics
             if (new_size <= 0) new_size = step;
             if (new_size > 0)
             {
+                if constexpr (requires{ buff.widen(si32{}, si32{}); })
+                {
+                    if (new_size + 1 > peak) // Grow in place keeping item positions.
+                    {
+                        auto delta = new_size + 1 - peak;
+                        auto index = BottomAnchored ? std::max(0, size - 1 - dst(cart, tail))
+                                                    : std::min(size - 1, dst(head, cart));
+                        if (size == 0)
+                        {
+                            buff.resize(peak + delta);
+                            head = 0;
+                            tail = peak + delta - 1;
+                        }
+                        else if (head > tail) // Open the gap after the tail.
+                        {
+                            buff.widen(tail + 1, delta);
+                            head += delta;
+                        }
+                        else buff.resize(peak + delta);
+                        peak += delta;
+                        cart = mod(head + std::max(0, index));
+                        return;
+                    }
+                }
                 if constexpr (BottomAnchored)
                 {
                     if (size > new_size)
@@ -60,6 +60,8 @@ namespace netxs::gui
 
         si32            win_state{};    // cfg_t: .
         bool            antialiasing{}; // cfg_t: .
+        si32            glyph_cache{};  // cfg_t: Glyph sprite cache size limit in megabytes.
+        bool            debug_logs{};   // cfg_t: Log the glyph cache counters.
         span            blink_rate{};   // cfg_t: .
         twod            wincoord{};     // cfg_t: .
         twod            gridsize{};     // cfg_t: .
@@ -188,6 +190,16 @@ namespace netxs::gui
             std::vector<irgb>      palette; // CPAL cached palette in rgb-linear space.
             std::unordered_map<si32, imagens::docs> svg_cache; // Face specific SVG-document cache. We storing several documents for the currentColor workaround.
 
+            // bare_face_t: Visit the fields stored in the font index file.
+            void fields(auto&& fx)
+            {
+                fx(face_index, face_flags, style_flags, num_glyphs, family_name, style_name, bbox, units_per_EM,
+                   ascender, descender, height, max_advance_width, max_advance_height, underline_position, underline_thickness,
+                   strikethroughPosition, strikethroughThickness, xHeight, capHeight, lineGap, is_color, is_monospaced, is_italic,
+                   weight_value, stretch_value, unicode_ranges, axes_map, is_variable_font, valid, mssymbol_codepage,
+                   width_target, weight_target, italic_target);
+            }
+
             auto get_weight_str() const
             {
                 if (weight_target.min != weight_target.max)
@@ -246,18 +258,198 @@ namespace netxs::gui
                 }
             }
         };
+        // fonts: Persistent font index (face metadata and coverage of the system font files keyed by file path and modification time).
+        struct index_t
+        {
+            struct file_t
+            {
+                text                           path;  // file_t: Font file path.
+                si64                           stamp; // file_t: Font file modification time.
+                std::vector<sptr<bare_face_t>> faces; // file_t: Faces found in the file.
+            };
+
+            static constexpr auto signature = "vtm font index v1\n"sv;
+
+            utf::unordered_map<text, file_t> files; // index_t: Font files by path.
+
+            static auto file_path()
+            {
+                return os::path::home / ".config/vtm/fontindex.bin";
+            }
+            static void put(text& block, auto const& item)
+            {
+                using type = std::decay_t<decltype(item)>;
+                if constexpr (std::is_same_v<type, text>)
+                {
+                    put(block, (ui32)item.size());
+                    block += item;
+                }
+                else if constexpr (std::is_same_v<type, axis_rec_t>)
+                {
+                    put(block, item.name);
+                    put(block, item.def);
+                    put(block, item.min);
+                    put(block, item.max);
+                }
+                else if constexpr (requires{ item.min; item.max; }) // limits<twod>.
+                {
+                    put(block, item.min);
+                    put(block, item.max);
+                }
+                else if constexpr (requires{ item.x; item.y; }) // twod.
+                {
+                    put(block, item.x);
+                    put(block, item.y);
+                }
+                else if constexpr (requires{ item.begin()->second; })
+                {
+                    put(block, (ui32)item.size());
+                    for (auto& [key, value] : item)
+                    {
+                        put(block, key);
+                        put(block, value);
+                    }
+                }
+                else
+                {
+                    static_assert(std::is_trivially_copyable_v<type>);
+                    block.append((char*)&item, sizeof(item));
+                }
+            }
+            static bool get(view& block, auto& item)
+            {
+                using type = std::decay_t<decltype(item)>;
+                if constexpr (std::is_same_v<type, text>)
+                {
+                    auto size = ui32{};
+                    if (!get(block, size) || block.size() < size) return faux;
+                    item = block.substr(0, size);
+                    block.remove_prefix(size);
+                    return true;
+                }
+                else if constexpr (std::is_same_v<type, axis_rec_t>)
+                {
+                    return get(block, item.name) && get(block, item.def) && get(block, item.min) && get(block, item.max);
+                }
+                else if constexpr (requires{ item.min; item.max; }) // limits<twod>.
+                {
+                    return get(block, item.min) && get(block, item.max);
+                }
+                else if constexpr (requires{ item.x; item.y; }) // twod.
+                {
+                    return get(block, item.x) && get(block, item.y);
+                }
+                else if constexpr (requires{ item.begin()->second; })
+                {
+                    auto size = ui32{};
+                    if (!get(block, size)) return faux;
+                    item.clear();
+                    while (size--)
+                    {
+                        auto key = typename type::key_type{};
+                        auto value = typename type::mapped_type{};
+                        if (!get(block, key) || !get(block, value)) return faux;
+                        item.emplace(key, std::move(value));
+                    }
+                    return true;
+                }
+                else
+                {
+                    static_assert(std::is_trivially_copyable_v<type>);
+                    if (block.size() < sizeof(item)) return faux;
+                    std::memcpy((void*)&item, block.data(), sizeof(item));
+                    block.remove_prefix(sizeof(item));
+                    return true;
+                }
+            }
+            // index_t: Load the index file. Return faux if the file is missing or malformed.
+            bool load()
+            {
+                auto data = text{};
+                if (!os::io::load_file(file_path(), data) || !data.starts_with(signature)) return faux;
+                auto block = view{ data };
+                block.remove_prefix(signature.size());
+                auto count = ui32{};
+                if (!get(block, count)) return faux;
+                while (count--)
+                {
+                    auto file = file_t{};
+                    auto faces = ui32{};
+                    if (!get(block, file.path) || !get(block, file.stamp) || !get(block, faces)) return faux;
+                    while (faces--)
+                    {
+                        auto& rec = *file.faces.emplace_back(ptr::shared<bare_face_t>());
+                        auto ok = true;
+                        rec.fields([&](auto&... args){ ok = (get(block, args) && ...); });
+                        if (!ok) return faux;
+                        rec.file_path = file.path;
+                        rec.file_stamp = os::fs::file_time_type{ os::fs::file_time_type::duration{ file.stamp } };
+                    }
+                    auto path = file.path;
+                    files[path] = std::move(file);
+                }
+                return true;
+            }
+            // index_t: Store the index file (write a temporary file and rename it over the index, so readers never see a torn file).
+            void save()
+            {
+                auto block = text{ signature };
+                put(block, (ui32)files.size());
+                for (auto& [path, file] : files)
+                {
+                    put(block, file.path);
+                    put(block, file.stamp);
+                    put(block, (ui32)file.faces.size());
+                    for (auto& rec_ptr : file.faces)
+                    {
+                        rec_ptr->fields([&](auto&... args){ (put(block, args), ...); });
+                    }
+                }
+                auto path = file_path();
+                auto ec = std::error_code{};
+                os::fs::create_directories(path.parent_path(), ec);
+                auto temp = path;
+                temp += utf::concat('.', os::process::id.first, ".tmp"); // Unique per process, so concurrent instances don't interleave.
+                auto file = std::ofstream{ temp, std::ios::binary | std::ios::trunc };
+                file.write(block.data(), block.size());
+                file.close(); // Flush before renaming.
+                auto done = !file.fail();
+                if (done) os::fs::rename(temp, path, ec);
+                if (!done || ec)
+                {
+                    os::fs::remove(temp, ec);
+                    log("%%Failed to write font index file '%path%'", prompt::gui, path.generic_string());
+                }
+            }
+        };
         struct loaded_font_file_t
         {
-            std::vector<byte> buffer;
+            os::io::fmap      mapping; // loaded_font_file_t: Memory mapped font file.
+            std::vector<byte> storage; // loaded_font_file_t: Font file copy if the file cannot be mapped.
+            std::span<byte>   buffer;  // loaded_font_file_t: Font file content.
 
             explicit operator bool () { return !buffer.empty(); }
 
             loaded_font_file_t(os::fs::path const& path)
             {
-                if (!os::io::load_file(path, buffer))
+                load(path);
+            }
+            bool load(os::fs::path const& path)
+            {
+                mapping = os::io::fmap{ path };
+                if (mapping)
+                {
+                    buffer = { mapping.data, mapping.size };
+                }
+                else if (os::io::load_file(path, storage))
+                {
+                    buffer = storage;
+                }
+                else
                 {
                     buffer = {};
                 }
+                return !buffer.empty();
             }
         };
         struct fthb_pair_t
@@ -348,13 +540,13 @@ namespace netxs::gui
                 auto& loaded_file_ptr = fcache.loaded_files[utf8_path];
                 if (!loaded_file_ptr)
                 {
-                    loaded_file_ptr = ptr::shared(loaded_font_file_t{ file_path });
+                    loaded_file_ptr = ptr::shared<loaded_font_file_t>(file_path);
                 }
                 loaded_file = loaded_file_ptr;
                 auto& file_buff = *(loaded_file);
                 auto raw_face = (FT_Face)nullptr;
-                if ((!file_buff && !os::io::load_file(file_path, file_buff.buffer))
-                    || FT_Err_Ok != ::FT_New_Memory_Face(fcache.ft_library.get(), file_buff.buffer.data(), (FT_Long)file_buff.buffer.size(), bare_face_ptr->face_index, &raw_face)) // Read a whole font/collection file (relatively slow, e.g. with 30Mb font files).
+                if ((!file_buff && !file_buff.load(file_path))
+                    || FT_Err_Ok != ::FT_New_Memory_Face(fcache.ft_library.get(), file_buff.buffer.data(), (FT_Long)file_buff.buffer.size(), bare_face_ptr->face_index, &raw_face)) // Map a whole font/collection file (pages are loaded on demand, e.g. with 30Mb font files).
                 {
                     log("%%Failed to load font family file '%family_name%' (style_id=%%): %filename%", prompt::gui, family_ref.family_name, font_style::str(style_id), utf8_path);
                     bare_face_ptr->valid = faux;
@@ -840,6 +1032,10 @@ namespace netxs::gui
                 rect b_box; // Bounding box in pixels.
             };
 
+            using runs = utf::unordered_map<text, std::vector<step_t>>;
+
+            static constexpr auto runs_limit = 4096; // Max number of cached glyph runs.
+
             fonts&              fcache;
             hb_font_t*          hb_font{};
             FT_Face             ft_face{};
@@ -848,6 +1044,8 @@ namespace netxs::gui
             sptr<bare_face_t>   bare_face_ptr;
             std::vector<step_t> glyphs;
             si32                colored{};
+            runs                shaped; // shaper: Shaping results by (face instance, face scale, script, direction, codepoints).
+            text                runkey; // shaper: Shaping cache key buffer.
 
             shaper(fonts& fcache)
                 : fcache{ fcache },
@@ -860,23 +1058,52 @@ namespace netxs::gui
                 ::hb_buffer_destroy(hb_buffer);
             }
 
+            // shaper: Drop all cached glyph runs (face instances are about to be released).
+            void reset()
+            {
+                shaped.clear();
+            }
             auto generate_glyph_run(std::vector<utfx>& codepoints, auto script, bool is_rtl, fp32 transform, bool is_monospaced, fp32 grid_step)
             {
-                ::hb_buffer_add_codepoints(hb_buffer, codepoints.data(), (si32)codepoints.size(), 0, (si32)codepoints.size());
-                ::hb_buffer_set_direction(hb_buffer, is_rtl ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
-                ::hb_buffer_set_script(hb_buffer, script);
-                ::hb_shape(hb_font, hb_buffer, nullptr, 0);
-                auto info = ::hb_buffer_get_glyph_infos(hb_buffer, &glyf_count);
-                auto pos  = ::hb_buffer_get_glyph_positions(hb_buffer, &glyf_count);
-                glyphs.resize(glyf_count);
-                for (auto i = 0u; i < glyf_count; i++)
-                {
-                    auto& glyph = glyphs[i];
-                    glyph.index = info[i].codepoint;
-                    glyph.width = pos[i].x_advance / 64.0f;                             // 26.6 format.
-                    glyph.align = { pos[i].x_offset / 64.0f, pos[i].y_offset / 64.0f }; //
-                }
-                ::hb_buffer_clear_contents(hb_buffer);
+                auto& metrics = ft_face->size->metrics;
+                auto field = [&](auto value){ runkey.append((char const*)&value, sizeof(value)); }; // Field by field: no padding bytes in the key.
+                runkey.clear();
+                field(hb_font);
+                field(metrics.x_scale);
+                field(metrics.y_scale);
+                field((ui32)script);
+                field((byte)is_rtl);
+                runkey.append((char*)codepoints.data(), codepoints.size() * sizeof(utfx));
+                if (auto iter = shaped.find(runkey); iter != shaped.end())
+                {
+                    glyphs = iter->second;
+                    glyf_count = (ui32)glyphs.size();
+                }
+                else
+                {
+                    ::hb_buffer_add_codepoints(hb_buffer, codepoints.data(), (si32)codepoints.size(), 0, (si32)codepoints.size());
+                    ::hb_buffer_set_direction(hb_buffer, is_rtl ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
+                    ::hb_buffer_set_script(hb_buffer, script);
+                    ::hb_shape(hb_font, hb_buffer, nullptr, 0);
+                    auto info = ::hb_buffer_get_glyph_infos(hb_buffer, &glyf_count);
+                    auto pos  = ::hb_buffer_get_glyph_positions(hb_buffer, &glyf_count);
+                    glyphs.resize(glyf_count);
+                    for (auto i = 0u; i < glyf_count; i++)
+                    {
+                        auto& glyph = glyphs[i];
+                        glyph.index = info[i].codepoint;
+                        glyph.width = pos[i].x_advance / 64.0f;                             // 26.6 format.
+                        glyph.align = { pos[i].x_offset / 64.0f, pos[i].y_offset / 64.0f }; //
+                    }
+                    ::hb_buffer_clear_contents(hb_buffer);
+                    if (shaped.size() >= runs_limit) // Evict half of the cached runs.
+                    {
+                        auto count = shaped.size() / 2;
+                        auto iter = shaped.begin();
+                        while (count--) iter = shaped.erase(iter);
+                    }
+                    shaped.emplace(runkey, glyphs);
+                }
                 auto length = 0.0f;
                 if (is_monospaced)
                 {
@@ -971,6 +1198,151 @@ namespace netxs::gui
             }
         }
 
+        // fonts: Read the face metadata and coverage of the font file.
+        static void scan_font_file(FT_Library ft_library, index_t::file_t& file)
+        {
+            auto face = FT_Face{};
+            auto index = 0;
+            while (FT_Err_Ok == ::FT_New_Face(ft_library, file.path.c_str(), index++, &face)) // Read headers only (fast enough).
+            {
+                if (auto os2 = (TT_OS2*)::FT_Get_Sfnt_Table(face, FT_SFNT_OS2)) // We need OS/2 metadata.
+                {
+                    auto family = qiew{ face->family_name };
+                    auto style  = qiew{ face->style_name };
+                    auto rec_ptr = file.faces.emplace_back(ptr::shared<bare_face_t>());
+                    auto& rec = *rec_ptr;
+                    rec.file_stamp             = os::fs::file_time_type{ os::fs::file_time_type::duration{ file.stamp } };
+                    rec.file_path              = file.path;
+                    rec.family_name            = family.str();
+                    rec.style_name             = style.str();
+                    rec.face_index             = face->face_index;
+                    rec.face_flags             = face->face_flags;
+                    rec.style_flags            = face->style_flags;
+                    rec.num_glyphs             = face->num_glyphs;
+                    rec.bbox                   = {{ face->bbox.xMin, face->bbox.yMin }, { face->bbox.xMax, face->bbox.yMax }};
+                    rec.units_per_EM           = face->units_per_EM;
+                    rec.ascender               = face->ascender;
+                    rec.descender              = -face->descender;
+                    rec.height                 = face->height;
+                    rec.max_advance_width      = face->max_advance_width;
+                    rec.max_advance_height     = face->max_advance_height;
+                    rec.underline_position     = face->underline_position;
+                    rec.underline_thickness    = face->underline_thickness;
+                    rec.strikethroughPosition  = os2->yStrikeoutPosition;
+                    rec.strikethroughThickness = os2->yStrikeoutSize;
+                    rec.lineGap                = os2->sTypoLineGap;
+                    auto has_colr = has_sfnt_table(face, FT_MAKE_TAG('C', 'O', 'L', 'R'));
+                    auto has_cpal = has_sfnt_table(face, FT_MAKE_TAG('C', 'P', 'A', 'L'));
+                    auto has_svg  = has_sfnt_table(face, FT_MAKE_TAG('S', 'V', 'G', ' '));
+                    rec.is_color = has_svg ? fonts::color_type::svg : (has_colr && has_cpal) ? fonts::color_type::colr : fonts::color_type::mono;
+                    rec.valid = rec.num_glyphs && rec.units_per_EM && (rec.is_color || FT_IS_SCALABLE(face));
+                    rec.is_monospaced          = FT_IS_FIXED_WIDTH(face);
+                    rec.weight_value           = os2->usWeightClass;
+                    rec.stretch_value          = os2->usWidthClass;
+                    rec.is_italic              = face->style_flags & FT_STYLE_FLAG_ITALIC;
+                    auto amaster = (FT_MM_Var*)nullptr;
+                    auto has_wdth = faux;
+                    auto has_wght = faux;
+                    auto has_ital = faux;
+                    if (FT_Err_Ok == ::FT_Get_MM_Var(face, &amaster))
+                    {
+                        rec.is_variable_font = true;
+                        for (auto i = 0u; i < amaster->num_axis; i++) // Axes count (weight, width, ital...)
+                        {
+                            auto& axis = amaster->axis[i];
+                            auto axis_values = axis_rec_t{ axis.name, axis.def / 65536.0f, axis.minimum / 65536.0f, axis.maximum / 65536.0f };
+                            rec.axes_map.emplace(axis.tag, axis_values);
+                            switch (axis.tag)
+                            {
+                                case cfg_t::ft_tag("wdth"): has_wdth = true; rec.width_target  = axis_values; break;
+                                case cfg_t::ft_tag("wght"): has_wght = true; rec.weight_target = axis_values; break;
+                                case cfg_t::ft_tag("ital"): has_ital = true; rec.italic_target = axis_values; break;
+                            }
+                        }
+                        ::FT_Done_MM_Var(ft_library, amaster);
+                    }
+                    // Bring basic parameters to a unified form - axes.
+                    if (!has_wdth)
+                    {
+                        static constexpr auto stretch_lut = std::to_array<fp32>(
+                        {
+                            50.0f,   // 1 Ultra-condensed 50%
+                            62.5f,   // 2 Extra-condensed 62.5%
+                            75.0f,   // 3 Condensed       75%
+                            87.5f,   // 4 Semi-condensed  87.5%
+                            100.0f,  // 5 Medium (Normal) 100%
+                            112.5f,  // 6 Semi-expanded   112.5%
+                            125.0f,  // 7 Expanded        125%
+                            150.0f,  // 8 Extra-expanded  150%
+                            200.0f,  // 9 Ultra-expanded  200%
+                        });
+                        auto wdth = stretch_lut[std::clamp(rec.stretch_value, 1, (si32)stretch_lut.size()) - 1];
+                        auto axis_values = axis_rec_t{ "Width", wdth, wdth, wdth };
+                        rec.axes_map.emplace(cfg_t::ft_tag("wdth"), axis_values);
+                        rec.width_target = axis_values;
+                    }
+                    if (!has_wght)
+                    {
+                        auto wght = (fp32)rec.weight_value;
+                        auto axis_values = axis_rec_t{ "Weight", wght, wght, wght };
+                        rec.axes_map.emplace(cfg_t::ft_tag("wght"), axis_values);
+                        rec.weight_target = axis_values;
+                    }
+                    if (!has_ital)
+                    {
+                        auto ital = (fp32)rec.is_italic;
+                        auto axis_values = axis_rec_t{ "Italic", ital, ital, ital };
+                        rec.axes_map.emplace(cfg_t::ft_tag("ital"), axis_values);
+                        rec.italic_target = axis_values;
+                    }
+                    if (!(os2->fsSelection & 0x80) || os2->version == 0xFFFF) // fsSelection bit 7 (0x80): USE_TYPO_METRICS.
+                    {
+                        if (auto hhea = (TT_HoriHeader*)::FT_Get_Sfnt_Table(face, FT_SFNT_HHEA)) // Old Mac fonts that do not include an 'OS/2' table. In this case, the `version` field is always set to 0xFFFF.
+                        {
+                            rec.lineGap = hhea->Line_Gap;
+                        }
+                    }
+                    if (os2->version != 0xFFFF && os2->version >= 2)
+                    {
+                        rec.xHeight   = os2->sxHeight;
+                        rec.capHeight = os2->sCapHeight;
+                    }
+                    if (rec.capHeight == 0) fonts::get_char_height(face, 'H', rec.capHeight, face->ascender);         // Arabic, emoji, web/windings have no capitals
+                    if (rec.xHeight   == 0) fonts::get_char_height(face, 'x', rec.xHeight,   face->ascender * 2 / 3); // or latin letters.
+                    // Fill supported unicode ranges.
+                    auto glyph_index = FT_UInt{};
+                    auto char_code = ::FT_Get_First_Char(face, &glyph_index);
+                    if (!glyph_index) // There is no FT_ENCODING_UNICODE code page. Try to select ms symbol code page.
+                    {
+                        ::FT_Select_Charmap(face, FT_ENCODING_MS_SYMBOL);
+                        char_code = ::FT_Get_First_Char(face, &glyph_index);
+                        log("%%Try to select 'MS Symbol' code page for '%%' font.", prompt::gui, rec.file_path.generic_string());
+                        if (glyph_index) rec.mssymbol_codepage = true;
+                    }
+                    if (glyph_index)
+                    {
+                        auto current_block = char_code / 256;
+                        auto bit_set = rec.unicode_ranges.try_emplace(current_block).first;
+                        bit_set->second.set(char_code % 256);
+                        while ((char_code = ::FT_Get_Next_Char(face, char_code, &glyph_index)))
+                        {
+                            auto next_block = char_code / 256;
+                            if (next_block != current_block)
+                            {
+                                current_block = next_block;
+                                bit_set = rec.unicode_ranges.try_emplace(current_block).first;
+                            }
+                            bit_set->second.set(char_code % 256);
+                        }
+                    }
+                    else
+                    {
+                        log("%%Font '%%' has no FT_ENCODING_UNICODE code page.", prompt::gui, rec.file_path.generic_string());
+                    }
+                }
+                ::FT_Done_Face(face);
+            }
+        }
         void set_cellsz(si32 cell_height)
         {
             cellsize = { 1, std::clamp(cell_height, 2, 256) };
@@ -1004,6 +1376,8 @@ namespace netxs::gui
         void set_fonts(std::list<text>& family_names, bool fresh = true)
         {
             families = family_names;
+            font_shaper.reset();
+            fallback_miss.clear();
             font_fallback.clear();
             if (!fresh) // Clear the "loaded" and "fixed" flags.
             {
@@ -1036,6 +1410,11 @@ namespace netxs::gui
         {
             for (auto& f : font_fallback) if ( f.family_ref.first_class() && fonts::hittest(f.family_ref.unicode_ranges, codepoints)) return f;
             for (auto& f : font_fallback) if (!f.family_ref.first_class() && fonts::hittest(f.family_ref.unicode_ranges, codepoints)) return f;
+            auto cluster = view{ (char*)codepoints.data(), codepoints.size() * sizeof(utfx) };
+            if (!force_mono && font_fallback.size() && fallback_miss.contains(cluster)) // The whole font index has already been scanned for this cluster.
+            {
+                return font_fallback.back();
+            }
             auto try_font = [&](font_family_t& family_rec, bool test)
             {
                 auto hit = !test || fonts::hittest(family_rec.unicode_ranges, codepoints);
@@ -1063,6 +1442,11 @@ namespace netxs::gui
             }
             if (font_fallback.size())
             {
+                if (!force_mono)
+                {
+                    if (fallback_miss.size() >= shaper::runs_limit) fallback_miss.clear();
+                    fallback_miss.emplace(cluster);
+                }
                 return font_fallback.back();
             }
             for (font_family_t& family_rec : font_index) // Take the first font found in the system if no fonts loaded yet.
@@ -1265,6 +1649,7 @@ namespace netxs::gui
         std::map<text, font_family_t>                      font_map;      // fonts: Map of available font families sorted by family name.
         std::vector<std::reference_wrapper<font_family_t>> font_index;    // fonts: Index of available font families ordered by filestamp.
         std::vector<font_face_t>                           font_fallback; // fonts: Fallback font list.
+        utf::unordered_set<text>                           fallback_miss; // fonts: Codepoint clusters not covered by any available font family (negative fallback cache).
         std::vector<font_face_t>                           svg_font_list; // fonts: SVG library font list.
         utf::unordered_map<text, sptr<loaded_font_file_t>> loaded_files;  // fonts: Map of loaded font files by file paths (path <-> blob).
         cfg_t::axis_vals_t                                 primary_axes;  // fonts: Map of the primary font axes (4byte_axis_tag <-> values).
@@ -1320,6 +1705,10 @@ namespace netxs::gui
                 auto system_font_flow = std::vector<fontfile_item_t>{};
             #endif
             auto font_list = std::vector<sptr<bare_face_t>>{};
+            auto stored = index_t{};
+            auto loaded = stored.load();
+            auto actual = index_t{};
+            auto pending = std::vector<index_t::file_t*>{};
             for (auto& item : system_font_flow)
             {
                 auto ec = std::error_code{};
@@ -1328,151 +1717,44 @@ namespace netxs::gui
                 {
                     log("%%Failed to get font file '%path%' modification time (error %ec%): %msg%", prompt::gui, item.data, ec.value(), os::get_system_error_message(ec.value()));
                 }
-                else
+                else if (!actual.files.contains(item.data)) // Skip duplicates.
                 {
-                    auto face = FT_Face{};
-                    auto index = 0;
-                    while (FT_Err_Ok == ::FT_New_Face(ft_library.get(), item.data.c_str(), index++, &face)) // Read headers only (fast enough).
+                    auto stamp = (si64)file_stamp.time_since_epoch().count();
+                    auto& file = actual.files[item.data];
+                    if (auto iter = stored.files.find(item.data); iter != stored.files.end() && iter->second.stamp == stamp) // Take unchanged files from the index.
                     {
-                        if (auto os2 = (TT_OS2*)::FT_Get_Sfnt_Table(face, FT_SFNT_OS2)) // We need OS/2 metadata.
-                        {
-                            auto family = qiew{ face->family_name };
-                            auto style  = qiew{ face->style_name };
-                            auto rec_ptr = font_list.emplace_back(ptr::shared<bare_face_t>());
-                            auto& rec = *rec_ptr;
-                            rec.file_stamp             = file_stamp;
-                            rec.file_path              = std::move(item.data);
-                            rec.family_name            = family.str();
-                            rec.style_name             = style.str();
-                            rec.face_index             = face->face_index;
-                            rec.face_flags             = face->face_flags;
-                            rec.style_flags            = face->style_flags;
-                            rec.num_glyphs             = face->num_glyphs;
-                            rec.bbox                   = {{ face->bbox.xMin, face->bbox.yMin }, { face->bbox.xMax, face->bbox.yMax }};
-                            rec.units_per_EM           = face->units_per_EM;
-                            rec.ascender               = face->ascender;
-                            rec.descender              = -face->descender;
-                            rec.height                 = face->height;
-                            rec.max_advance_width      = face->max_advance_width;
-                            rec.max_advance_height     = face->max_advance_height;
-                            rec.underline_position     = face->underline_position;
-                            rec.underline_thickness    = face->underline_thickness;
-                            rec.strikethroughPosition  = os2->yStrikeoutPosition;
-                            rec.strikethroughThickness = os2->yStrikeoutSize;
-                            rec.lineGap                = os2->sTypoLineGap;
-                            auto has_colr = has_sfnt_table(face, FT_MAKE_TAG('C', 'O', 'L', 'R'));
-                            auto has_cpal = has_sfnt_table(face, FT_MAKE_TAG('C', 'P', 'A', 'L'));
-                            auto has_svg  = has_sfnt_table(face, FT_MAKE_TAG('S', 'V', 'G', ' '));
-                            rec.is_color = has_svg ? fonts::color_type::svg : (has_colr && has_cpal) ? fonts::color_type::colr : fonts::color_type::mono;
-                            rec.valid = rec.num_glyphs && rec.units_per_EM && (rec.is_color || FT_IS_SCALABLE(face));
-                            rec.is_monospaced          = FT_IS_FIXED_WIDTH(face);
-                            rec.weight_value           = os2->usWeightClass;
-                            rec.stretch_value          = os2->usWidthClass;
-                            rec.is_italic              = face->style_flags & FT_STYLE_FLAG_ITALIC;
-                            auto amaster = (FT_MM_Var*)nullptr;
-                            auto has_wdth = faux;
-                            auto has_wght = faux;
-                            auto has_ital = faux;
-                            if (FT_Err_Ok == ::FT_Get_MM_Var(face, &amaster))
-                            {
-                                rec.is_variable_font = true;
-                                for (auto i = 0u; i < amaster->num_axis; i++) // Axes count (weight, width, ital...)
-                                {
-                                    auto& axis = amaster->axis[i];
-                                    auto axis_values = axis_rec_t{ axis.name, axis.def / 65536.0f, axis.minimum / 65536.0f, axis.maximum / 65536.0f };
-                                    rec.axes_map.emplace(axis.tag, axis_values);
-                                    switch (axis.tag)
-                                    {
-                                        case cfg_t::ft_tag("wdth"): has_wdth = true; rec.width_target  = axis_values; break;
-                                        case cfg_t::ft_tag("wght"): has_wght = true; rec.weight_target = axis_values; break;
-                                        case cfg_t::ft_tag("ital"): has_ital = true; rec.italic_target = axis_values; break;
-                                    }
-                                }
-                                ::FT_Done_MM_Var(ft_library.get(), amaster);
-                            }
-                            // Bring basic parameters to a unified form - axes.
-                            if (!has_wdth)
-                            {
-                                static constexpr auto stretch_lut = std::to_array<fp32>(
-                                {
-                                    50.0f,   // 1 Ultra-condensed 50%
-                                    62.5f,   // 2 Extra-condensed 62.5%
-                                    75.0f,   // 3 Condensed       75%
-                                    87.5f,   // 4 Semi-condensed  87.5%
-                                    100.0f,  // 5 Medium (Normal) 100%
-                                    112.5f,  // 6 Semi-expanded   112.5%
-                                    125.0f,  // 7 Expanded        125%
-                                    150.0f,  // 8 Extra-expanded  150%
-                                    200.0f,  // 9 Ultra-expanded  200%
-                                });
-                                auto wdth = stretch_lut[std::clamp(rec.stretch_value, 1, (si32)stretch_lut.size()) - 1];
-                                auto axis_values = axis_rec_t{ "Width", wdth, wdth, wdth };
-                                rec.axes_map.emplace(cfg_t::ft_tag("wdth"), axis_values);
-                                rec.width_target = axis_values;
-                            }
-                            if (!has_wght)
-                            {
-                                auto wght = (fp32)rec.weight_value;
-                                auto axis_values = axis_rec_t{ "Weight", wght, wght, wght };
-                                rec.axes_map.emplace(cfg_t::ft_tag("wght"), axis_values);
-                                rec.weight_target = axis_values;
-                            }
-                            if (!has_ital)
-                            {
-                                auto ital = (fp32)rec.is_italic;
-                                auto axis_values = axis_rec_t{ "Italic", ital, ital, ital };
-                                rec.axes_map.emplace(cfg_t::ft_tag("ital"), axis_values);
-                                rec.italic_target = axis_values;
-                            }
-                            if (!(os2->fsSelection & 0x80) || os2->version == 0xFFFF) // fsSelection bit 7 (0x80): USE_TYPO_METRICS.
-                            {
-                                if (auto hhea = (TT_HoriHeader*)::FT_Get_Sfnt_Table(face, FT_SFNT_HHEA)) // Old Mac fonts that do not include an 'OS/2' table. In this case, the `version` field is always set to 0xFFFF.
-                                {
-                                    rec.lineGap = hhea->Line_Gap;
-                                }
-                            }
-                            if (os2->version != 0xFFFF && os2->version >= 2)
-                            {
-                                rec.xHeight   = os2->sxHeight;
-                                rec.capHeight = os2->sCapHeight;
-                            }
-                            if (rec.capHeight == 0) fonts::get_char_height(face, 'H', rec.capHeight, face->ascender);         // Arabic, emoji, web/windings have no capitals
-                            if (rec.xHeight   == 0) fonts::get_char_height(face, 'x', rec.xHeight,   face->ascender * 2 / 3); // or latin letters.
-                            // Fill supported unicode ranges.
-                            auto glyph_index = FT_UInt{};
-                            auto char_code = ::FT_Get_First_Char(face, &glyph_index);
-                            if (!glyph_index) // There is no FT_ENCODING_UNICODE code page. Try to select ms symbol code page.
-                            {
-                                ::FT_Select_Charmap(face, FT_ENCODING_MS_SYMBOL);
-                                char_code = ::FT_Get_First_Char(face, &glyph_index);
-                                log("%%Try to select 'MS Symbol' code page for '%%' font.", prompt::gui, rec.file_path.generic_string());
-                                if (glyph_index) rec.mssymbol_codepage = true;
-                            }
-                            if (glyph_index)
-                            {
-                                auto current_block = char_code / 256;
-                                auto bit_set = rec.unicode_ranges.try_emplace(current_block).first;
-                                bit_set->second.set(char_code % 256);
-                                while ((char_code = ::FT_Get_Next_Char(face, char_code, &glyph_index)))
-                                {
-                                    auto next_block = char_code / 256;
-                                    if (next_block != current_block)
-                                    {
-                                        current_block = next_block;
-                                        bit_set = rec.unicode_ranges.try_emplace(current_block).first;
-                                    }
-                                    bit_set->second.set(char_code % 256);
-                                }
-                            }
-                            else
-                            {
-                                log("%%Font '%%' has no FT_ENCODING_UNICODE code page.", prompt::gui, rec.file_path.generic_string());
-                            }
-                        }
-                        ::FT_Done_Face(face);
+                        file = std::move(iter->second);
+                    }
+                    else
+                    {
+                        file.path = item.data;
+                        file.stamp = stamp;
+                        pending.push_back(&file);
                     }
                 }
             }
+            if (pending.size()) // Rescan new and modified files using a separate FreeType instance per thread.
+            {
+                auto scan = [](index_t::file_t* file_ptr)
+                {
+                    static thread_local auto thread_ft_library = make_ft_library();
+                    if (thread_ft_library) scan_font_file(thread_ft_library.get(), *file_ptr);
+                };
+                #if defined(_WIN32)
+                    std::for_each(std::execution::par, pending.begin(), pending.end(), scan);
+                #else
+                    std::for_each(pending.begin(), pending.end(), scan);
+                #endif
+                log("%%Font index updated: %% of %% files rescanned", prompt::gui, pending.size(), actual.files.size());
+            }
+            if (pending.size() || !loaded || stored.files.size() != actual.files.size() - pending.size()) // Files were added, modified or removed.
+            {
+                actual.save();
+            }
+            for (auto& [path, file] : actual.files)
+            {
+                font_list.insert(font_list.end(), file.faces.begin(), file.faces.end());
+            }
             //std::ranges::sort(font_list, std::ranges::greater{}, &bare_face_t::stamp);
             //std::ranges::sort(font_list, [](auto& a, auto& b){ return std::tie(a.stamp, a.name) < std::tie(b.stamp, b.name); }); // With std::tie, sorting all fields is only possible in one direction.
             std::sort(font_list.begin(), font_list.end(), [](auto a_ptr, auto b_ptr)
@@ -1600,22 +1882,53 @@ namespace netxs::gui
             static constexpr auto wavyunderline = __COUNTER__ - _counter;
         };
 
-        using gmap = std::unordered_map<ui64, sprite>;
+        struct entry
+        {
+            using list = std::list<ui64>;
+
+            sprite         mask; // entry: Glyph sprite.
+            list::iterator iter; // entry: Position in the recently used list.
+            arch           size; // entry: Bytes charged to the cache.
+
+            entry(auto& pool)
+                : mask{ pool },
+                  size{}
+            { }
+        };
+        struct stat
+        {
+            ui64 hits{}; // stat: Sprite lookups served from the cache.
+            ui64 miss{}; // stat: Sprites rasterized on demand.
+            ui64 drop{}; // stat: Sprites evicted to keep the cache within its limit.
+            arch size{}; // stat: Bytes currently held by cached sprites.
+        };
+
+        using gmap = std::unordered_map<ui64, entry>;
 
         std::pmr::unsynchronized_pool_resource buffer_pool; // glyph: Pool for temp buffers.
-        std::pmr::monotonic_buffer_resource    mono_buffer; // glyph: Memory block for sprites.
+        std::pmr::unsynchronized_pool_resource sprite_pool; // glyph: Pool for sprites (reuses the storage of evicted sprites).
         fonts&                                 fcache;      // glyph: Font cache.
         twod&                                  cellsz;      // glyph: Terminal cell size in pixels.
         bool                                   aamode;      // glyph: Enable AA.
         gmap                                   glyphs;      // glyph: Glyph map.
+        entry::list                            recent;      // glyph: Glyph tokens ordered from the most to the least recently used.
+        arch                                   limit;       // glyph: Glyph map size limit in bytes.
+        stat                                   status;      // glyph: Glyph map counters.
+        stat                                   logged;      // glyph: Glyph map counters at the last report.
+        time                                   logtime;     // glyph: Time of the next report.
+        bool                                   logstat;     // glyph: Report the counters to the log.
+        bool                                   frozen;      // glyph: Glyph map is read-only (shared between parallel band renderers).
         std::vector<sprite>                    cgi_glyphs;  // glyph: Synthetic glyphs.
         std::vector<sprite>                    cgi_shadow;  // glyph: Synthetic shadow.
         std::vector<utfx>                      codepoints;  // glyph: Codepoint list for shaping.
 
-        glyph(fonts& fcache, bool aamode)
+        glyph(fonts& fcache, bool aamode, si32 cache_mb, bool logstat)
             : fcache{ fcache },
               cellsz{ fcache.cellsize },
-              aamode{ aamode }
+              aamode{ aamode },
+              limit{ (arch)std::max(1, cache_mb) << 20 },
+              logstat{ logstat },
+              frozen{ faux }
         {
             if (fcache)
             {
@@ -1827,12 +2140,100 @@ namespace netxs::gui
                 block.coor.x += fract * 3;
             }
         }
+        // glyph: Evict the least recently used sprites until the cache fits the limit (the most recent one is always kept).
+        void trim()
+        {
+            while (status.size > limit && recent.size() > 1)
+            {
+                auto iter = glyphs.find(recent.back());
+                status.size -= iter->second.size;
+                status.drop++;
+                glyphs.erase(iter);
+                recent.pop_back();
+            }
+        }
+        // glyph: Return the cached sprite for the token (create an empty one if it is missing and allowed).
+        entry* take(ui64 token, bool create)
+        {
+            auto iter = glyphs.find(token);
+            if (iter == glyphs.end())
+            {
+                if (!create) return nullptr;
+                iter = glyphs.emplace(token, sprite_pool).first;
+                recent.push_front(token);
+                iter->second.iter = recent.begin();
+            }
+            else if (iter->second.iter != recent.begin())
+            {
+                recent.splice(recent.begin(), recent, iter->second.iter);
+            }
+            return &iter->second;
+        }
+        // glyph: Return the cached sprite for the token without touching the recently used list (thread-safe while frozen).
+        entry* peek(ui64 token)
+        {
+            auto iter = glyphs.find(token);
+            return iter != glyphs.end() ? &iter->second : nullptr;
+        }
+        // glyph: Return the glyph map key for the cell.
+        static auto token_of(cell const& c)
+        {
+            auto token = c.tkn();
+            if (c.itc()) token ^= 0xAAAA'AAAA'AAAA'AA00; // Randomize token to differentiate italics (0xb101010...0000'0000 excluding matrix metadata).
+            if (c.bld()) token ^= 0x5555'5555'5555'5500; // Randomize token to differentiate bolds (0xb010101...0000'0000 excluding matrix metadata).
+            return token;
+        }
+        // glyph: Rasterize all missing sprites of the cell range once (FreeType and HarfBuzz are not thread-safe). Return faux if the range contains images.
+        bool prepare(auto head, auto tail)
+        {
+            while (head != tail)
+            {
+                auto& c = *head++;
+                if (c.get_image_index()) return faux; // Image rasters are built lazily under the image lock.
+                if (c.hid() || c.xy() == 0) continue;
+                if (auto item_ptr = take(token_of(c), c.jgc()))
+                {
+                    auto& item = *item_ptr;
+                    if (item.mask.type == sprite::undef)
+                    {
+                        if (c.jgc())
+                        {
+                            status.miss++;
+                            rasterize(item.mask, c);
+                            charge(item);
+                        }
+                    }
+                    else status.hits++;
+                }
+            }
+            return true;
+        }
+        // glyph: Charge the freshly rasterized sprite to the cache.
+        void charge(entry& item)
+        {
+            item.size = sizeof(entry) + sizeof(ui64) * 4/*map and list nodes*/ + item.mask.bits.capacity() * sizeof(ui32);
+            status.size += item.size;
+        }
+        // glyph: Log the cache counters if they have changed (at most once every 10 seconds unless forced).
+        void report(bool forced = faux)
+        {
+            if (!logstat) return;
+            auto now = datetime::now();
+            if (!forced && now < logtime) return;
+            logtime = now + 10s;
+            if (status.hits == logged.hits && status.miss == logged.miss && status.drop == logged.drop && status.size == logged.size) return;
+            logged = status;
+            log("%%Glyph cache: %% sprites, %% bytes, hits: %%, misses: %%, evictions: %%", prompt::gui, glyphs.size(), status.size, status.hits, status.miss, status.drop);
+        }
         void reset()
         {
+            report(true);
             glyphs.clear();
+            recent.clear();
+            status.size = 0;
             cgi_glyphs.clear();
             cgi_shadow.clear();
-            mono_buffer.release();
+            sprite_pool.release();
             generate_glyphs();
             generate_shadow();
             reset_cached_rasters();
@@ -2506,10 +2907,8 @@ namespace netxs::gui
                 glyph_mask.transform<irgb>(flip_swap, matrix);
             }
         }
-        void rasterize_svg_document(imagens::image::bitmap_t& bitmap, imagens::docs& dom, qiew sub_id, imagens::image::gb_attrs_t& gb_attrs)
+        void rasterize_document(imagens::image::bitmap_t& bitmap, fp2d orig_full_sz_fp, imagens::image::gb_attrs_t& gb_attrs, auto draw)
         {
-            auto& image_dom = *dom[0];
-            auto orig_full_sz_fp = fp2d{ image_dom.width(), image_dom.height() }; // Original doc size (float).
             auto u   = gb_attrs[imagens::gb::u  ];
             auto v   = gb_attrs[imagens::gb::v  ];
             auto uw  = gb_attrs[imagens::gb::uw ];
@@ -2558,7 +2957,7 @@ namespace netxs::gui
             auto tmp_document_block = full_doc_tmp_buffer.raster<irgb>();
             tmp_document_block.zeroize();
             auto offset_inside_document = uv * orig_full_sz_fp * scale;
-            rasterize_svg_DOM(tmp_document_block, dom, scale, offset_inside_document, sub_id);
+            draw(tmp_document_block, scale, offset_inside_document);
 
             // Trim all transparent pixels.
             auto nested_fragment_area = full_doc_tmp_buffer.get_minimal_non_transparent_area_for_pma<irgb>();
@@ -2569,6 +2968,50 @@ namespace netxs::gui
                 netxs::onbody(tmp_document_block, dst_fragment_block, [](auto& src, auto& dst){ dst = src; });
             }
         }
+        void rasterize_svg_document(imagens::image::bitmap_t& bitmap, imagens::docs& dom, qiew sub_id, imagens::image::gb_attrs_t& gb_attrs)
+        {
+            auto& image_dom = *dom[0];
+            auto orig_full_sz_fp = fp2d{ image_dom.width(), image_dom.height() }; // Original doc size (float).
+            rasterize_document(bitmap, orig_full_sz_fp, gb_attrs, [&](auto& canvas, fp2d scale, fp2d offset_inside_document)
+            {
+                rasterize_svg_DOM(canvas, dom, scale, offset_inside_document, sub_id);
+            });
+        }
+        void rasterize_pixmap_document(imagens::image::bitmap_t& bitmap, twod pixmap_size, std::span<argb const> pixels, imagens::image::gb_attrs_t& gb_attrs)
+        {
+            rasterize_document(bitmap, fp2d{ pixmap_size }, gb_attrs, [&](auto& canvas, fp2d scale, fp2d offset_inside_document)
+            {
+                static thread_local auto columns = std::vector<si32>{};
+                auto size = canvas.area().size;
+                auto source = [](si32 i, fp32 offset, fp32 scale, si32 limit) // Nearest neighbor sampling.
+                {
+                    auto s = (si32)std::floor((i + 0.5f + offset) / scale);
+                    return s >= 0 && s < limit ? s : -1;
+                };
+                columns.resize(size.x);
+                for (auto x = 0; x < size.x; x++)
+                {
+                    columns[x] = source(x, offset_inside_document.x, scale.x, pixmap_size.x);
+                }
+                for (auto y = 0; y < size.y; y++)
+                {
+                    auto row = source(y, offset_inside_document.y, scale.y, pixmap_size.y);
+                    if (row < 0) continue;
+                    auto src_row = pixels.subspan((size_t)row * pixmap_size.x, pixmap_size.x);
+                    for (auto x = 0; x < size.x; x++)
+                    {
+                        if (auto col = columns[x]; col >= 0)
+                        {
+                            auto src_px = src_row[col];
+                            if (src_px.chan.a)
+                            {
+                                canvas[twod{ x, y }] = irgb::nonpma_srgb_to_pma_linear(src_px);
+                            }
+                        }
+                    }
+                }
+            });
+        }
         void draw_glyph(auto& canvas, sprite& glyph_mask, twod offset, argb fgc, bool semi_transparent = faux)
         {
             auto box = glyph_mask.area.shift(offset);
@@ -2644,13 +3087,20 @@ namespace netxs::gui
         {
             if (bitmap.fragment.type == sprite::undef && image.document.size())
             {
-                if (!image.dom[0])
+                if (auto [pixmap_size, pixels] = imagens::pixmap::decode(image.document); pixels.size()) // Raw pixels (e.g. Sixel).
                 {
-                    image.dom = generate_DOM(image.document);
+                    rasterize_pixmap_document(bitmap, pixmap_size, pixels, gb_attrs);
                 }
-                if (image.dom[0])
+                else
                 {
-                    rasterize_svg_document(bitmap, image.dom, sub_id, gb_attrs);
+                    if (!image.dom[0])
+                    {
+                        image.dom = generate_DOM(image.document);
+                    }
+                    if (image.dom[0])
+                    {
+                        rasterize_svg_document(bitmap, image.dom, sub_id, gb_attrs);
+                    }
                 }
             }
             if (bitmap.fragment.area)
@@ -2849,27 +3299,26 @@ namespace netxs::gui
                 {
                     break;
                 }
-                auto token = c.tkn();
-                if (c.itc()) token ^= 0xAAAA'AAAA'AAAA'AA00; // Randomize token to differentiate italics (0xb101010...0000'0000 excluding matrix metadata).
-                if (c.bld()) token ^= 0x5555'5555'5555'5500; // Randomize token to differentiate bolds (0xb010101...0000'0000 excluding matrix metadata).
-                auto iter = glyphs.find(token);
-                if (iter == glyphs.end())
+                auto token = token_of(c);
+                auto item_ptr = frozen ? peek(token) : take(token, c.jgc());
+                if (!item_ptr) break;
+                auto& item = *item_ptr;
+                auto& glyph_mask = item.mask;
+                if (frozen)
                 {
-                    if (c.jgc())
-                    {
-                        iter = glyphs.emplace(token, mono_buffer).first;
-                    }
-                    else break;
+                    if (glyph_mask.type == sprite::undef) break;
                 }
-                auto& glyph_mask = iter->second;
-                if (glyph_mask.type == sprite::undef)
+                else if (glyph_mask.type == sprite::undef)
                 {
                     if (c.jgc())
                     {
+                        status.miss++;
                         rasterize(glyph_mask, c);
+                        charge(item);
                     }
                     else break;
                 }
+                else status.hits++;
                 if (glyph_mask.area)
                 {
                     auto [w, h, x, y] = c.whxy();
@@ -2892,6 +3341,7 @@ namespace netxs::gui
                         draw_glyph(target, glyph_mask, offset, fgc, c.inv());
                     }
                 }
+                if (status.size > limit && !frozen) trim();
                 //if (bgc.alpha()< 2 && fgc == argb{ purewhite })
                 //{
                 //    // hilight glyph edges
@@ -3520,7 +3970,7 @@ namespace netxs::gui
               titles{ *this, "", "", faux },
               wfocus{ *this, ui::pro::focus::mode::relay },
               fcache{ config.font_names, config.font_axes, config.cell_height },//, [&]{ netxs::set_flag<task::all>(reload); window_post_command(ipc::no_command); } },
-              gcache{ fcache, config.antialiasing },
+              gcache{ fcache, config.antialiasing, config.glyph_cache, config.debug_logs },
               blinks{ .init = config.blink_rate },
               cellsz{ fcache.cellsize },
               origsz{ fcache.cellsize.y },
@@ -4076,10 +4526,10 @@ namespace netxs::gui
                 }
             }
         }
-        void fill_stripe(auto head, auto tail, twod start = {}, si32 offset = {})
+        // winbase: Draw the cell range and return the blinking cells count delta.
+        si32 fill_cells(bits prime_canvas, bits blink_canvas, auto head, auto tail, twod start, si32 offset, auto strike)
         {
-            auto prime_canvas = layer_get_bits(master);
-            auto blink_canvas = layer_get_bits(blinky);
+            auto poll = 0;
             auto origin = blink_canvas.coor();
             //todo blinks.mask size is out of sync on intensive resize
             auto iter = blinks.mask.begin() + offset;
@@ -4091,15 +4541,15 @@ namespace netxs::gui
                 auto& b = *iter++;
                 if (std::exchange(b, c.blk()) != b)
                 {
-                    if (b) blinks.poll++;
+                    if (b) poll++;
                     else
                     {
-                        blinks.poll--;
+                        poll--;
                         netxs::onrect(blink_canvas, p, cell::shaders::wipe);
-                        blinky.strike(p);
+                        strike(p);
                     }
                 }
-                if (b) blinky.strike(p);
+                if (b) strike(p);
                 if (c.cur()) draw_cell_with_cursor(prime_canvas, p, c, blink_canvas);
                 else         gcache.draw_cell(prime_canvas, p, c, blink_canvas);
                 p.coor.x += cellsz.x;
@@ -4110,6 +4560,58 @@ namespace netxs::gui
                     if (p.coor.y >= m.y) break;
                 }
             }
+            return poll;
+        }
+        void fill_stripe(auto head, auto tail, twod start = {}, si32 offset = {})
+        {
+            auto prime_canvas = layer_get_bits(master);
+            auto blink_canvas = layer_get_bits(blinky);
+            blinks.poll += fill_cells(prime_canvas, blink_canvas, head, tail, start, offset, [&](rect r){ blinky.strike(r); });
+        }
+        // winbase: Draw the whole cell grid by horizontal bands in parallel.
+        void fill_bands(core& grid)
+        {
+            static constexpr auto band_rows = 4; // Rows per band.
+            struct band_t
+            {
+                si32              index; // band_t: Band number.
+                si32              delta; // band_t: Blinking cells count delta.
+                std::vector<rect> hits;  // band_t: Blinking layer dirty regions.
+            };
+            auto head = grid.begin();
+            auto tail = grid.end();
+            auto count = (si32)(tail - head);
+            auto width = std::max(1, grid.size().x);
+            auto bands = netxs::divupper(count / width, band_rows);
+            if (bands < 2 || !gcache.prepare(head, tail)) // Missing glyphs are rasterized by prepare() only once per token.
+            {
+                fill_stripe(head, tail);
+                return;
+            }
+            auto prime_canvas = layer_get_bits(master);
+            auto blink_canvas = layer_get_bits(blinky);
+            auto stripes = std::vector<band_t>(bands);
+            for (auto i = 0; i < bands; i++) stripes[i].index = i;
+            auto fill = [&](band_t& band)
+            {
+                auto offset = band.index * band_rows * width;
+                auto limit = band.index == bands - 1 ? count : offset + band_rows * width;
+                auto start = twod{ 0, band.index * band_rows } * cellsz;
+                band.delta = fill_cells(prime_canvas, blink_canvas, head + offset, head + limit, start, offset, [&](rect r){ band.hits.push_back(r); });
+            };
+            gcache.frozen = true;
+            #if defined(_WIN32)
+                std::for_each(std::execution::par, stripes.begin(), stripes.end(), fill);
+            #else
+                std::for_each(stripes.begin(), stripes.end(), fill);
+            #endif
+            gcache.frozen = faux;
+            gcache.trim();
+            for (auto& band : stripes)
+            {
+                blinks.poll += band.delta;
+                for (auto r : band.hits) blinky.strike(r);
+            }
         }
         void draw_grid(layer& s, auto& facedata, bool apply_contour = true) //todo just output ui::core
         {
@@ -4244,7 +4746,8 @@ namespace netxs::gui
                     }
                     auto bitmap_lock = stream.bitmap_dtvt.freeze();
                     auto& grid = bitmap_lock.thing.image;
-                    fill_stripe(grid.begin(), grid.end());
+                    fill_bands(grid);
+                    gcache.report();
                     if (fsmode == winstate::maximized)
                     {
                         auto canvas = layer_get_bits(master);
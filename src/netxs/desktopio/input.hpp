@@ -1969,6 +1969,20 @@ namespace netxs::input
             mouse_disabled = true;
             keybd_disabled = true;
         }
+        // hids: Return the object by the id taken from the rendered id map.
+        //       If the object is gone because its window was closed since the last render, route to the window uncovered at the point.
+        sptr resolve(id_t next_id, twod world_coor)
+        {
+            auto next_ptr = base::getref(next_id);
+            if (!next_ptr)
+            if (auto world_ptr = multihome.world_wptr.lock())
+            {
+                auto probe = hitpoint{ .coor = world_coor };
+                world_ptr->base::signal(tier::request, ui::e2::form::layout::hittest, probe);
+                if (probe.id) next_ptr = base::getref(probe.id);
+            }
+            return next_ptr;
+        }
         void fire(hint new_cause)//, si32 new_index = mouse::noactive)
         {
             if (mouse_disabled) return;
@@ -1998,7 +2012,7 @@ namespace netxs::input
             else
             {
                 auto next_id = idmap.link(mouse::coord);
-                if (auto next_ptr = next_id != owner.id ? base::getref(next_id) : sptr{})
+                if (auto next_ptr = next_id != owner.id ? resolve(next_id, twod{ mouse::coord } + gate_coor) : sptr{})
                 {
                     auto& next = *next_ptr;
                     pass(tier::mousepreview, next, gate_coor, true);
@@ -2041,7 +2055,7 @@ namespace netxs::input
                                         : idmap.link(m_sys.coordxy);
             if (next_id != owner.id)
             {
-                if (auto next_ptr = base::getref(next_id))
+                if (auto next_ptr = mouse::swift ? base::getref(next_id) : resolve(next_id, twod{ m_sys.coordxy } + idmap.coor()))
                 {
                     auto& next = *next_ptr;
                     auto  temp = m_sys.coordxy;
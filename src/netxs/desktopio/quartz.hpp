@@ -75,6 +75,127 @@ namespace netxs::datetime
         return milliseconds;
     }
 
+    // quartz: Hierarchical timer wheel with millisecond resolution.
+    //         Four levels of 64 slots cover about 4.6 hours, farther deadlines are kept aside.
+    template<class Item>
+    class wheel
+    {
+        static constexpr auto bits = 6;
+        static constexpr auto slots = 1 << bits;
+        static constexpr auto depth = 4;
+        static constexpr auto never = std::numeric_limits<ui64>::max();
+
+        struct entry
+        {
+            ui64 stamp;
+            Item item;
+        };
+
+        using bulk = std::vector<entry>;
+
+        std::array<std::array<bulk, slots>, depth> rings; // wheel: Slot rings by level.
+        std::array<ui64, depth>                    masks; // wheel: Occupied slots bitmap by level.
+        bulk                                       aside; // wheel: Entries beyond the wheel horizon.
+        ui64                                       clock; // wheel: Last processed moment (ms).
+
+        static auto ticks(time t)
+        {
+            return (ui64)std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+        }
+        // wheel: Put the entry on the lowest level whose window contains the current moment.
+        void place(entry&& e)
+        {
+            for (auto level = 0; level < depth; level++)
+            {
+                auto shift = bits * (level + 1);
+                if ((e.stamp >> shift) == (clock >> shift))
+                {
+                    auto index = (e.stamp >> (bits * level)) & (slots - 1);
+                    rings[level][index].push_back(std::move(e));
+                    masks[level] |= 1ull << index;
+                    return;
+                }
+            }
+            aside.push_back(std::move(e));
+        }
+        // wheel: Return the nearest moment something has to be done (fire or cascade).
+        ui64 upcoming() const
+        {
+            auto nearest = never;
+            for (auto level = 0; level < depth; level++)
+            {
+                auto shift = bits * level;
+                auto index = (clock >> shift) & (slots - 1);
+                if (auto pending = masks[level] & (~0ull << index))
+                {
+                    auto window = clock >> (shift + bits) << (shift + bits);
+                    nearest = std::min(nearest, window | ((ui64)std::countr_zero(pending) << shift));
+                }
+            }
+            for (auto& e : aside)
+            {
+                static constexpr auto shift = bits * depth;
+                nearest = std::min(nearest, e.stamp >> shift << shift);
+            }
+            return nearest;
+        }
+        // wheel: Take the slot content out.
+        auto take(si32 level, ui64 index)
+        {
+            masks[level] &= ~(1ull << index);
+            return std::exchange(rings[level][index], bulk{});
+        }
+
+    public:
+        wheel()
+            : masks{},
+              clock{ ticks(datetime::now()) }
+        { }
+
+        // wheel: Register the item to be fired at the deadline (not earlier than the next millisecond).
+        void add(time deadline, Item item)
+        {
+            auto stamp = ticks(deadline + std::chrono::milliseconds{ 1 } - span{ 1 }); // Round up.
+            place({ std::max(stamp, clock + 1), std::move(item) });
+        }
+        // wheel: Fire all items whose deadline has come.
+        template<class P>
+        void advance(time now, P fire)
+        {
+            auto target = ticks(now);
+            while (true)
+            {
+                auto nearest = upcoming();
+                if (nearest > target) break;
+                clock = nearest;
+                if (aside.size() && std::ranges::any_of(aside, [&](auto& e){ return (e.stamp >> (bits * depth)) == (clock >> (bits * depth)); }))
+                {
+                    for (auto& e : std::exchange(aside, bulk{})) place(std::move(e));
+                }
+                for (auto level = depth - 1; level > 0; level--) // Cascade entries that have reached the current window.
+                {
+                    auto index = (clock >> (bits * level)) & (slots - 1);
+                    if (masks[level] & (1ull << index))
+                    {
+                        for (auto& e : take(level, index)) place(std::move(e));
+                    }
+                }
+                auto index = clock & (slots - 1);
+                if (masks[0] & (1ull << index))
+                {
+                    for (auto& e : take(0, index)) fire(e.item);
+                }
+            }
+            clock = std::max(clock, target);
+        }
+        // wheel: Return the moment of the next required advance.
+        time next() const
+        {
+            auto nearest = upcoming();
+            return nearest == never ? maxtime : time{ std::chrono::milliseconds{ nearest } };
+        }
+    };
+
     template<class T>
     class quartz
     {
@@ -84,15 +205,16 @@ namespace netxs::datetime
         T&   owner;
         flag alive;
         flag letup;
+        bool awake;
         span delay;
         span watch;
         span pulse;
         work fiber;
         cond synch;
+        std::mutex mutex;
 
         void worker()
         {
-            auto mutex = std::mutex{};
             auto guard = std::unique_lock{ mutex };
 
             auto now = datetime::now();
@@ -104,17 +226,24 @@ namespace netxs::datetime
                 prior =  now;
 
                 now = datetime::now();
-                owner.timer(now);
+                awake = faux;
+                guard.unlock();
+                auto beat = now + (pulse - now.time_since_epoch() % pulse);
+                auto next = owner.timer(now, beat); // The owner asks for the next pulse only while someone is ticking, otherwise for the nearest deadline.
+                guard.lock();
 
                 if (letup.exchange(faux))
                 {
                     synch.wait_for(guard, delay);
                     delay = span::zero();
                 }
+                else if (next == maxtime)
+                {
+                    synch.wait(guard, [&]{ return awake || !alive; });
+                }
                 else
                 {
-                    auto trail = pulse - now.time_since_epoch() % pulse;
-                    synch.wait_for(guard, trail);
+                    synch.wait_until(guard, next, [&]{ return awake || !alive; });
                 }
             }
         }
@@ -124,6 +253,7 @@ namespace netxs::datetime
             : owner{ owner        },
               alive{ faux         },
               letup{ faux         },
+              awake{ faux         },
               delay{ span::zero() },
               watch{ span::zero() },
               pulse{ span::max()  }
@@ -150,6 +280,13 @@ namespace netxs::datetime
             delay = pause2;
             letup = true;
         }
+        // quartz: Wake up the worker to reevaluate the next deadline.
+        void wake()
+        {
+            auto guard = std::lock_guard{ mutex };
+            awake = true;
+            synch.notify_one();
+        }
         bool stopwatch(span p)
         {
             if (watch > p)
@@ -166,7 +303,10 @@ namespace netxs::datetime
         {
             if (alive.exchange(faux))
             {
-                synch.notify_all();
+                {
+                    auto guard = std::lock_guard{ mutex };
+                    synch.notify_all();
+                }
                 if (fiber.joinable())
                 {
                     fiber.join();
@@ -1532,11 +1532,181 @@ namespace netxs::ui
         }
     };
 
+    // richtext: Recycling allocator for line cell storage. Blocks are rounded up to power-of-two size classes and kept in per-thread free lists.
+    template<class T>
+    struct cellalloc
+    {
+        using value_type = T;
+
+        static constexpr auto min_bits = 3;  // cellalloc: The smallest size class (8 items).
+        static constexpr auto max_bits = 11; // cellalloc: The largest size class (2048 items). Larger blocks bypass the free lists.
+        static constexpr auto budget = 1_sz << 20; // cellalloc: Max free bytes kept per size class per thread.
+
+        struct slab
+        {
+            std::array<std::vector<void*>, max_bits - min_bits + 1> lists; // slab: Free blocks by size class.
+
+            ~slab()
+            {
+                for (auto& list : lists) for (auto block : list) ::operator delete(block);
+                closed() = true; // Blocks released during the remaining thread teardown go straight to the heap.
+            }
+        };
+        static auto& closed()
+        {
+            static thread_local auto done = faux;
+            return done;
+        }
+        static auto& local()
+        {
+            static thread_local auto inst = slab{};
+            return inst;
+        }
+        static auto index(size_t n)
+        {
+            return n <= (1_sz << min_bits) ? 0 : (si32)std::bit_width(n - 1) - min_bits;
+        }
+
+        // cellalloc: Return the number of items actually allocated for a request of n items.
+        static auto block_size(size_t n)
+        {
+            return n == 0 || n > (1_sz << max_bits) ? n : 1_sz << (index(n) + min_bits);
+        }
+
+        cellalloc() = default;
+        template<class U>
+        cellalloc(cellalloc<U> const&) { }
+
+        T* allocate(size_t n)
+        {
+            if (n > (1_sz << max_bits) || closed()) return (T*)::operator new(n * sizeof(T));
+            auto i = index(n);
+            auto& list = local().lists[i];
+            if (list.size())
+            {
+                auto block = list.back();
+                list.pop_back();
+                return (T*)block;
+            }
+            return (T*)::operator new(sizeof(T) << (i + min_bits));
+        }
+        void deallocate(T* block, size_t n)
+        {
+            if (n > (1_sz << max_bits) || closed()) return ::operator delete(block);
+            auto i = index(n);
+            auto& list = local().lists[i];
+            if ((list.size() + 1) * (sizeof(T) << (i + min_bits)) <= budget) list.push_back(block);
+            else                                                               ::operator delete(block);
+        }
+        friend bool operator == (cellalloc const&, cellalloc const&) { return true; }
+    };
+
+    // richtext: Line cell storage. Lines with identical content may share one immutable copy until modified (copy-on-write).
+    class cellbody
+    {
+    public:
+        using vect = std::vector<cell, cellalloc<cell>>;
+
+    private:
+        using sptr = netxs::sptr<vect const>;
+
+        vect local; // cellbody: Exclusive content.
+        sptr share; // cellbody: Shared immutable content (local is empty while shared).
+
+        auto& own()
+        {
+            if (share)
+            {
+                auto hold = std::move(share);
+                local.assign(hold->begin(), hold->end());
+            }
+            return local;
+        }
+        auto& get() const
+        {
+            return share ? *share : local;
+        }
+
+        friend struct cellpool;
+
+    public:
+        cellbody() = default;
+        template<class It>
+        cellbody(It head, It tail)
+            : local(head, tail)
+        { }
+
+        auto begin()          { return own().begin();                                 }
+        auto end()            { return own().end();                                   }
+        auto begin() const    { return get().begin();                                 }
+        auto end() const      { return get().end();                                   }
+        auto size() const     { return get().size();                                  }
+        auto empty() const    { return get().empty();                                 }
+        auto capacity() const { return cellalloc<cell>::block_size(get().capacity()); } // Size class actually allocated.
+        auto shared() const   { return share.get();                                   }
+        auto weight() const   { return (si64)(capacity() * sizeof(cell)) / (share ? share.use_count() : 1); } // Shared content is split among its owners.
+        auto& operator [] (size_t i)       { return own()[i];                         }
+        auto& operator [] (size_t i) const { return get()[i];                         }
+        operator std::span<cell const> () const { return get();                       }
+        void clear()                           { share.reset(); local.clear();        }
+        void resize(size_t n)                  { own().resize(n);                     }
+        void resize(size_t n, cell const& c)   { own().resize(n, c);                  }
+        void assign(size_t n, cell const& c)   { share.reset(); local.assign(n, c);   }
+        void swap(cellbody& b)                 { local.swap(b.local); share.swap(b.share); }
+        auto erase(vect::const_iterator head, vect::const_iterator tail) { return own().erase(head, tail); }
+        template<class It>
+        void assign(It head, It tail)
+        {
+            auto hold = std::move(share); // The source may be our own shared content.
+            local.assign(head, tail);
+        }
+    };
+    // richtext: Interning pool for finished line content.
+    struct cellpool
+    {
+        using vect = cellbody::vect;
+        using wptr = netxs::wptr<vect const>;
+
+        std::unordered_multimap<size_t, wptr> items; // cellpool: Shared content by hash.
+        size_t                                limit{ 1024 }; // cellpool: Expired entries cleanup threshold.
+
+        // cellpool: Share the line content with identical lines.
+        void share(cellbody& b)
+        {
+            if (b.share || b.local.empty()) return;
+            auto size = b.local.size() * sizeof(cell);
+            auto hash = std::hash<view>{}(view{ (char const*)b.local.data(), size });
+            auto [head, tail] = items.equal_range(hash);
+            while (head != tail)
+            {
+                if (auto p = head->second.lock())
+                {
+                    if (p->size() == b.local.size() && 0 == std::memcmp(p->data(), b.local.data(), size)) // Bytewise, since cell::operator== ignores link ids.
+                    {
+                        vect().swap(b.local);
+                        b.share = std::move(p);
+                        return;
+                    }
+                }
+                ++head;
+            }
+            auto p = ptr::shared<vect const>(std::move(b.local));
+            vect().swap(b.local);
+            items.emplace(hash, p);
+            b.share = std::move(p);
+            if (items.size() > limit)
+            {
+                std::erase_if(items, [](auto& item){ return item.second.expired(); });
+                limit = std::max(1024_sz, items.size() * 2);
+            }
+        }
+    };
+
     // richtext: 1D cell run.
     struct line
     {
         using type = deco::type;
-        using body = std::vector<cell>;
+        using body = cellbody;
 
         body cells{}; // line: Cell data.
         cell brush{}; // line: Current brush.
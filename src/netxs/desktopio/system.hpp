@@ -33,6 +33,7 @@
     #include <sys/param.h>   //
     #include <sys/types.h>   // ::getaddrinfo(), ::sysctl()
     #include <sys/socket.h>  // ::shutdown() ::socket(2)
+    #include <sys/uio.h>     // ::writev()
     #include <netdb.h>       //
     //#include <arpa/inet.h>  // ::inet_ntop() ?This may require dynamic linking. #GH696
 
@@ -47,6 +48,7 @@
     #include <syslog.h>     // syslog, daemonize
 
     #include <sys/stat.h>   // ::chmod()
+    #include <sys/mman.h>   // ::mmap()
     #include <fcntl.h>      // ::splice()
 
     #if __has_include(<features.h>)
@@ -55,6 +57,7 @@
 
     #if defined(__linux__)
         #include <sys/vt.h> // ::console_ioctl()
+        #include <sys/epoll.h> // ::epoll_create1()
         #if defined(__ANDROID__)
             #include <linux/kd.h>   // ::console_ioctl()
         #else
@@ -1684,6 +1687,218 @@ namespace netxs::os
         void bell() { reset(); }
     };
 
+    #if defined(__linux__)
+
+    struct reactor // Shared epoll readers for descriptors that used to hold a dedicated thread each.
+    {
+        using hndl = std::function<bool(qiew)>; // Return faux to stop watching. An empty qiew signals EOF. Called on the relay thread, never on the polling thread.
+
+        static constexpr auto backlog = 1048576_sz; // reactor: Unhandled bytes per descriptor after which it is not polled until the handler catches up.
+
+        struct item
+        {
+            reactor& host; // item: Owning reactor.
+            fd_t     fd; // item: Watched descriptor.
+            hndl     proc; // item: Data handler.
+            ui64     serial; // item: Registration id (epoll user data).
+            text     pend{}; // item: Received data waiting for the handler.
+            bool     queued{}; // item: Queued for the relay thread.
+            bool     ended{}; // item: No more reading (EOF, error, handler request or cancellation).
+            bool     muted{}; // item: Polling is suspended by the backlog limit.
+        };
+        using iptr = netxs::sptr<item>;
+
+        fd_t                               epfd; // reactor: Epoll descriptor.
+        fire                               alarm; // reactor: Shutdown signal.
+        std::mutex                         mutex; // reactor: State access.
+        std::condition_variable            synch; // reactor: Relay queue and in-flight state changes.
+        std::unordered_map<ui64, iptr>     items; // reactor: Watched descriptors by serial.
+        std::deque<iptr>                   queue; // reactor: Items with pending data or EOF.
+        ui64                               issued{}; // reactor: Last assigned serial (zero is the shutdown signal).
+        item*                              reading{}; // reactor: Item being read by the polling thread.
+        item*                              running{}; // reactor: Item whose handler is being called by the relay thread.
+        bool                               broken{}; // reactor: Polling has failed, new descriptors are rejected.
+        bool                               closed{}; // reactor: Relay shutdown.
+        std::thread                        agent; // reactor: Polling thread.
+        std::thread                        relay; // reactor: Handler thread (parsing may block on locks without stalling reads).
+
+        reactor()
+            : epfd{ ::epoll_create1(EPOLL_CLOEXEC) }
+        {
+            ok(epfd, "::epoll_create1()", os::unexpected);
+            auto ev = ::epoll_event{ .events = EPOLLIN, .data = { .u64 = 0 }};
+            ok(::epoll_ctl(epfd, EPOLL_CTL_ADD, alarm, &ev), "::epoll_ctl(EPOLL_CTL_ADD)", os::unexpected);
+            agent = std::thread{ [&]{ worker(); }};
+            relay = std::thread{ [&]{ handler(); }};
+        }
+       ~reactor()
+        {
+            alarm.reset();
+            if (agent.joinable()) agent.join();
+            {
+                auto guard = std::lock_guard{ mutex };
+                closed = true;
+            }
+            synch.notify_all();
+            if (relay.joinable()) relay.join();
+            os::close(epfd);
+        }
+        // reactor: Watch the descriptor. The descriptor must stay open until the handler gets EOF or the item is cancelled.
+        iptr attach(fd_t fd, hndl proc)
+        {
+            auto guard = std::lock_guard{ mutex };
+            if (broken) return {};
+            auto i = ptr::shared<item>(*this, fd, std::move(proc), ++issued);
+            auto ev = ::epoll_event{ .events = EPOLLIN, .data = { .u64 = i->serial }}; // Level-triggered: one read per readiness keeps descriptors blocking for writers.
+            if (!ok(::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev), "::epoll_ctl(EPOLL_CTL_ADD)", os::unexpected))
+            {
+                return {};
+            }
+            items.emplace(i->serial, i);
+            return i;
+        }
+        // reactor: Stop watching the descriptor (mutex must be held).
+        void finish(item& i)
+        {
+            i.ended = true;
+            ::epoll_ctl(epfd, EPOLL_CTL_DEL, i.fd, nullptr);
+        }
+        // reactor: Queue the item for the relay thread (mutex must be held).
+        void post(iptr const& i)
+        {
+            if (i->queued) return;
+            i->queued = true;
+            queue.push_back(i);
+            synch.notify_all();
+        }
+        // reactor: Stop watching the descriptor without notifying the handler. Return when neither its read nor its handler is in flight.
+        void revoke(item& i)
+        {
+            auto guard = std::unique_lock{ mutex };
+            auto nested = std::this_thread::get_id() == relay.get_id(); // Cancelled from a handler.
+            synch.wait(guard, [&]{ return reading != &i && (nested || running != &i); });
+            if (!i.ended) finish(i);
+            i.proc = {};
+            items.erase(i.serial);
+        }
+        // reactor: Reject new descriptors and signal EOF to all watchers (polling is no longer possible).
+        void abandon()
+        {
+            auto guard = std::lock_guard{ mutex };
+            broken = true;
+            for (auto& [serial, i] : items)
+            {
+                if (!i->ended) finish(*i);
+                post(i);
+            }
+        }
+        void worker()
+        {
+            auto buffer = text(os::pipebuf, '\0');
+            auto events = std::array<::epoll_event, 64>{};
+            while (!alarm.fired)
+            {
+                auto count = ::epoll_wait(epfd, events.data(), (si32)events.size(), -1);
+                if (count < 0)
+                {
+                    if (errno == EINTR) continue;
+                    os::fail("::epoll_wait()");
+                    abandon();
+                    break;
+                }
+                for (auto& ev : std::span{ events.data(), (size_t)count })
+                {
+                    if (!ev.data.u64) continue; // Shutdown signal.
+                    auto guard = std::unique_lock{ mutex };
+                    auto iter = items.find(ev.data.u64);
+                    if (iter == items.end() || iter->second->ended) continue; // Stale event of a removed descriptor.
+                    auto i = iter->second;
+                    reading = i.get();
+                    guard.unlock();
+                    auto size = ::read(i->fd, buffer.data(), buffer.size());
+                    auto error = errno;
+                    guard.lock();
+                    reading = {};
+                    synch.notify_all();
+                    if (i->ended || (size < 0 && (error == EINTR || error == EAGAIN))) continue;
+                    if (size <= 0) finish(*i); // EOF, or EIO on a pty master whose slave has been closed.
+                    else
+                    {
+                        i->pend.append(buffer.data(), size);
+                        if (i->pend.size() >= backlog && !i->muted) // Let the kernel buffer apply backpressure to the writer.
+                        {
+                            i->muted = true;
+                            auto ev = ::epoll_event{ .events = 0, .data = { .u64 = i->serial }};
+                            ::epoll_ctl(epfd, EPOLL_CTL_MOD, i->fd, &ev);
+                        }
+                    }
+                    post(i);
+                }
+            }
+        }
+        void handler()
+        {
+            auto data = text{};
+            auto guard = std::unique_lock{ mutex };
+            while ((void)synch.wait(guard, [&]{ return queue.size() || closed; }), !closed)
+            {
+                auto i = std::move(queue.front());
+                queue.pop_front();
+                i->queued = faux;
+                if (!i->proc) continue; // Cancelled.
+                data.clear();
+                std::swap(data, i->pend);
+                auto ended = i->ended;
+                if (i->muted && !ended)
+                {
+                    i->muted = faux;
+                    auto ev = ::epoll_event{ .events = EPOLLIN, .data = { .u64 = i->serial }};
+                    ::epoll_ctl(epfd, EPOLL_CTL_MOD, i->fd, &ev);
+                }
+                running = i.get();
+                guard.unlock();
+                auto alive = data.empty() || i->proc(qiew{ data });
+                guard.lock();
+                if ((!alive || ended) && i->proc)
+                {
+                    if (!i->ended) finish(*i); // Handler request.
+                    auto proc = std::move(i->proc);
+                    i->proc = {};
+                    items.erase(i->serial);
+                    guard.unlock();
+                    proc({}); // Notify after deregistration, so the owner is free to close and reuse the descriptor.
+                    guard.lock();
+                }
+                running = {};
+                synch.notify_all();
+            }
+        }
+        // reactor: Watch the descriptor using one of the shared reactors.
+        static iptr watch(fd_t fd, hndl proc)
+        {
+            static auto mutex = std::mutex{};
+            static auto index = size_t{};
+            static auto pool = std::vector<uptr<reactor>>{};
+            auto guard = std::lock_guard{ mutex };
+            if (pool.empty())
+            {
+                auto count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+                while (count--) pool.emplace_back(std::make_unique<reactor>());
+            }
+            auto& r = *pool[index++ % pool.size()];
+            return r.attach(fd, std::move(proc));
+        }
+        // reactor: Stop watching the descriptor. The handler is not called after this returns.
+        //          Waits for its in-flight handler call, so don't call it holding a lock that handler may wait for.
+        static void cancel(iptr& i)
+        {
+            if (i) i->host.revoke(*i);
+            i.reset();
+        }
+    };
+
+    #endif
+
     namespace signals // Process-wide signals disposition.
     {
         #if defined(_WIN32)
@@ -1859,6 +2074,50 @@ namespace netxs::os
             }
             return faux;
         }
+        // io: Gather write.
+        auto send(fd_t fd, std::span<view const> list)
+        {
+            #if defined(_WIN32)
+                for (auto block : list)
+                {
+                    if (block.size() && !io::send(fd, block.data(), block.size())) return faux;
+                }
+                return true;
+            #else
+                static constexpr auto limit = 64_sz; // Well below the IOV_MAX.
+                auto iovec = std::array<::iovec, limit>{};
+                while (list.size())
+                {
+                    auto count = 0_sz;
+                    auto taken = 0_sz;
+                    for (; taken < list.size() && count < limit; taken++)
+                    {
+                        auto block = list[taken];
+                        if (block.size()) iovec[count++] = { .iov_base = (void*)block.data(), .iov_len = block.size() };
+                    }
+                    list = list.subspan(taken);
+                    auto iter = iovec.data();
+                    while (count)
+                    {
+                        auto result = ::writev(fd, iter, (int)count);
+                        if (result <= 0) return faux;
+                        auto sent = (size_t)result;
+                        while (count && sent >= iter->iov_len) // Drop completed blocks.
+                        {
+                            sent -= iter->iov_len;
+                            iter++;
+                            count--;
+                        }
+                        if (count) // Partially written block.
+                        {
+                            iter->iov_base = (char*)iter->iov_base + sent;
+                            iter->iov_len -= sent;
+                        }
+                    }
+                }
+                return true;
+            #endif
+        }
         template<class T, class Size_t>
         auto recv(fd_t fd, T* buffer, Size_t size)
         {
@@ -2060,6 +2319,223 @@ namespace netxs::os
             }
             return done;
         }
+        // os::io: Read-only memory mapped file.
+        struct fmap
+        {
+            byte*  data{};
+            size_t size{};
+
+            explicit operator bool () const { return data; }
+
+            fmap() = default;
+            fmap(fmap const&) = delete;
+            fmap(fmap&& f)
+                : data{ std::exchange(f.data, nullptr) },
+                  size{ std::exchange(f.size, 0) }
+            { }
+            fmap& operator = (fmap&& f)
+            {
+                std::swap(data, f.data);
+                std::swap(size, f.size);
+                return *this;
+            }
+            fmap(os::fs::path const& path)
+            {
+                #if defined(_WIN32)
+                    auto file = ::CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                    if (file == os::invalid_fd) return;
+                    auto length = LARGE_INTEGER{};
+                    if (::GetFileSizeEx(file, &length) && length.QuadPart)
+                    {
+                        if (auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+                        {
+                            data = (byte*)::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                            size = data ? (size_t)length.QuadPart : 0;
+                            os::close(mapping); // The view keeps the mapping alive.
+                        }
+                    }
+                    os::close(file);
+                #else
+                    auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                    if (file == os::invalid_fd) return;
+                    struct stat st = {};
+                    if (::fstat(file, &st) == 0 && st.st_size)
+                    {
+                        auto addr = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+                        if (addr != MAP_FAILED)
+                        {
+                            data = (byte*)addr;
+                            size = (size_t)st.st_size;
+                        }
+                    }
+                    os::close(file);
+                #endif
+            }
+            ~fmap()
+            {
+                if (data)
+                {
+                    #if defined(_WIN32)
+                        ::UnmapViewOfFile(data);
+                    #else
+                        ::munmap(data, size);
+                    #endif
+                }
+            }
+        };
+        // os::io: Append-only recording of timestamped output chunks.
+        //         File layout: "vtmrec01" followed by chunks [ui64 LE: microseconds since start][ui32 LE: size][size bytes].
+        struct vtrec
+        {
+            static constexpr auto signature = "vtmrec01"sv;
+            static constexpr auto headsize = sizeof(ui64) + sizeof(ui32);
+            static constexpr auto extent = 4194304_sz; // vtrec: File growth step (multiple of any page size).
+
+            time   start{}; // vtrec: Recording start time.
+            size_t used{};  // vtrec: Bytes written.
+            #if defined(_WIN32)
+            std::ofstream file; // vtrec: Recording file.
+            #else
+            fd_t   file{ os::invalid_fd }; // vtrec: Recording file.
+            byte*  base{};   // vtrec: Mapped extent.
+            size_t mapoff{}; // vtrec: Mapped extent file offset.
+            size_t maplen{}; // vtrec: Mapped extent length.
+            #endif
+
+            vtrec() = default;
+            vtrec(vtrec const&) = delete;
+           ~vtrec()
+            {
+                close();
+            }
+            explicit operator bool () const
+            {
+                #if defined(_WIN32)
+                    return file.is_open();
+                #else
+                    return file != os::invalid_fd;
+                #endif
+            }
+            #if not defined(_WIN32)
+            void unmap()
+            {
+                if (base) ::munmap(base, maplen);
+                base = {};
+                maplen = 0;
+            }
+            bool remap(size_t need) // Map the extent containing the write position with room for at least `need` bytes.
+            {
+                unmap();
+                mapoff = used / extent * extent;
+                maplen = (used - mapoff + need + extent - 1) / extent * extent;
+                // Reserve disk blocks up front: a store into a sparse hole on a full disk raises SIGBUS.
+                #if defined(__APPLE__)
+                    auto room = fstore_t{ .fst_flags = F_ALLOCATEALL, .fst_posmode = F_PEOFPOSMODE, .fst_offset = 0, .fst_length = (off_t)maplen };
+                    if (::fcntl(file, F_PREALLOCATE, &room) == -1 || ::ftruncate(file, (off_t)(mapoff + maplen)) != 0) return faux;
+                #else
+                    if (auto rc = ::posix_fallocate(file, (off_t)mapoff, (off_t)maplen))
+                    {
+                        errno = rc; // posix_fallocate returns the error code instead of setting errno.
+                        return faux;
+                    }
+                #endif
+                auto addr = ::mmap(nullptr, maplen, PROT_READ | PROT_WRITE, MAP_SHARED, file, (off_t)mapoff);
+                if (addr == MAP_FAILED)
+                {
+                    maplen = 0;
+                    return faux;
+                }
+                base = (byte*)addr;
+                return true;
+            }
+            #endif
+            void append(void const* data, size_t size)
+            {
+                #if defined(_WIN32)
+                    file.write((char const*)data, size);
+                #else
+                    if (used + size > mapoff + maplen && !remap(size))
+                    {
+                        os::fail("vtrec: Failed to extend the recording file");
+                        close();
+                        return;
+                    }
+                    std::memcpy(base + (used - mapoff), data, size);
+                #endif
+                used += size;
+            }
+            bool open(fs::path const& path)
+            {
+                close();
+                #if defined(_WIN32)
+                    file.open(path, std::ios::binary | std::ios::trunc);
+                #else
+                    file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+                #endif
+                if (!*this) return faux;
+                start = datetime::now();
+                used = 0;
+                append(signature.data(), signature.size());
+                return !!*this;
+            }
+            void close()
+            {
+                if (!*this) return;
+                #if defined(_WIN32)
+                    file.close();
+                #else
+                    unmap();
+                    (void)!::ftruncate(file, (off_t)used); // Drop the unused tail of the last extent.
+                    os::close(file);
+                #endif
+            }
+            void write(view data)
+            {
+                if (!*this || data.empty()) return;
+                auto when = netxs::letoh(datetime::round<ui64, std::chrono::microseconds>(datetime::now() - start));
+                auto size = netxs::letoh((ui32)data.size());
+                auto head = std::array<byte, headsize>{};
+                std::memcpy(head.data(), &when, sizeof(when));
+                std::memcpy(head.data() + sizeof(when), &size, sizeof(size));
+                append(head.data(), head.size());
+                if (*this) append(data.data(), data.size());
+            }
+        };
+        // os::io: Memory mapped recording reader.
+        struct vtply
+        {
+            fmap   file; // vtply: Mapped recording.
+            size_t iter; // vtply: Read position.
+
+            vtply(fs::path const& path)
+                : file{ path },
+                  iter{ vtrec::signature.size() }
+            {
+                if (file.size < iter || view{ (char*)file.data, iter } != vtrec::signature) file = {};
+            }
+            explicit operator bool () const
+            {
+                return !!file;
+            }
+            // vtply: Return the next chunk and its offset from the recording start, or an empty chunk at the end.
+            auto next()
+            {
+                auto when = span{};
+                auto data = view{};
+                if (file && file.size - iter >= vtrec::headsize)
+                {
+                    auto head = file.data + iter;
+                    auto size = (size_t)netxs::aligned<ui32>(head + sizeof(ui64));
+                    if (file.size - iter - vtrec::headsize >= size)
+                    {
+                        when = std::chrono::microseconds{ netxs::aligned<ui64>(head) };
+                        data = view{ (char*)head + vtrec::headsize, size };
+                        iter += vtrec::headsize + size;
+                    }
+                }
+                return std::pair{ when, data };
+            }
+        };
     }
 
     namespace env
@@ -3392,6 +3868,11 @@ namespace netxs::os
                 pipe::isbusy = faux; // io::send blocks until the send is complete.
                 return io::send(handle.w, buff);
             }
+            virtual bool send(std::span<view const> list) override
+            {
+                pipe::isbusy = faux;
+                return io::send(handle.w, list);
+            }
             virtual qiew recv(char* buff, size_t size) override
             {
                 auto result = qiew{};
@@ -3466,6 +3947,16 @@ namespace netxs::os
                     }
                     return faux;
                 }
+                auto send(std::span<view const> list)
+                {
+                    auto guard = std::unique_lock{ mutex };
+                    if (alive)
+                    {
+                        for (auto block : list) store += block;
+                        wsync.notify_one();
+                    }
+                    return alive;
+                }
                 auto read(text& yield)
                 {
                     auto guard = std::unique_lock{ mutex };
@@ -3528,6 +4019,10 @@ namespace netxs::os
             {
                 return client->send(data);
             }
+            bool send(std::span<view const> list) override
+            {
+                return client->send(list);
+            }
             std::ostream& show(std::ostream& s) const override
             {
                 return s << "local pipe: server=" << std::showbase << std::hex << server.get() << " client=" << std::showbase << std::hex << client.get();
@@ -4404,6 +4899,12 @@ namespace netxs::os
             text                    writebuf{};
             std::mutex              writemtx{};
             std::condition_variable writesyn{};
+            #if defined(__linux__)
+            std::thread             stdwrite{}; // vtty: Writing thread (reactor mode).
+            os::reactor::iptr       outwatch{}; // vtty: Reactor registration of the app output.
+            os::reactor::iptr       errwatch{}; // vtty: Reactor registration of the app stderr.
+            std::function<void()>   finalize{}; // vtty: One-shot disconnection notification (reactor mode).
+            #endif
 
             operator bool () { return attached; }
 
@@ -4425,6 +4926,16 @@ namespace netxs::os
                     if constexpr (debugmode) log(prompt::dtvt, "Reading thread joining", ' ', utf::to_hex_0x(stdinput.get_id()));
                     stdinput.join();
                 }
+                #if defined(__linux__)
+                os::reactor::cancel(outwatch);
+                os::reactor::cancel(errwatch);
+                if (stdwrite.joinable())
+                {
+                    if constexpr (debugmode) log(prompt::dtvt, "Writing thread joining", ' ', utf::to_hex_0x(stdwrite.get_id()));
+                    stdwrite.join();
+                }
+                if (auto proc = std::exchange(finalize, {})) proc(); // The output was being read by the reactor.
+                #endif
                 if constexpr (debugmode) log(prompt::dtvt, "Destructor complete");
             }
             void writer()
@@ -4601,6 +5112,63 @@ namespace netxs::os
                 }
                 return result;
             }
+            #if defined(__linux__)
+            // vtty: Read the app output and stderr using the shared reactor instead of dedicated threads.
+            bool watch_dtvt_app(text cmd, auto receiver_fx, auto shutdown_fx)
+            {
+                auto errflow = ptr::shared<text>();
+                auto errproc = [&, errflow](qiew shot)
+                {
+                    if (shot)
+                    {
+                        *errflow += shot;
+                        auto crop = qiew{ *errflow };
+                        utf::purify(crop);
+                        if (crop)
+                        {
+                            log("%%stderr[%stderrid%]: %msg%", prompt::dtvt, stderrid, ansi::err(crop));
+                            errflow->erase(0, crop.size()); // Delete processed data.
+                        }
+                    }
+                    return true;
+                };
+                auto outflow = ptr::shared<text>();
+                auto outproc = [&, outflow, receiver_fx](qiew shot)
+                {
+                    if (shot)
+                    {
+                        *outflow += shot;
+                        if (auto crop = directvt::binary::stream::purify(*outflow))
+                        {
+                            receiver_fx(crop);
+                            outflow->erase(0, crop.size()); // Delete processed data.
+                        }
+                        return true;
+                    }
+                    if constexpr (debugmode) log(prompt::dtvt, "Reactor reading ended");
+                    attached.exchange(faux);
+                    writesyn.notify_one(); // Interrupt writing thread.
+                    if (auto proc = std::exchange(finalize, {})) proc();
+                    return faux;
+                };
+                finalize = [cmd, shutdown_fx]
+                {
+                    log("%%Process '%cmd%' disconnected", prompt::dtvt, ansi::hi(utf::debase437(cmd)));
+                    shutdown_fx();
+                };
+                errwatch = os::reactor::watch(termlink.handle.e, errproc);
+                outwatch = os::reactor::watch(termlink.handle.r, outproc);
+                if (!outwatch)
+                {
+                    os::reactor::cancel(errwatch);
+                    finalize = {};
+                    return faux;
+                }
+                if constexpr (debugmode) log(prompt::dtvt, "Reactor reading started");
+                stdwrite = std::thread{ [&]{ writer(); } };
+                return true;
+            }
+            #endif
             void run_dtvt_app(eccc& appcfg, twod initsize, auto connect_fx, auto receiver_fx, auto shutdown_fx)
             {
                 stdinput = std::thread{ [&, appcfg, initsize, connect_fx, receiver_fx, shutdown_fx]
@@ -4639,6 +5207,9 @@ namespace netxs::os
                         attached.exchange(true);
                         stderrid = (arch)termlink.handle.e;
                         if constexpr (debugmode) log("%%DirectVT Gateway [%stderrid%] created for process '%cmd%'", prompt::dtvt, stderrid, ansi::hi(utf::debase437(cmd)));
+                        #if defined(__linux__)
+                        if (watch_dtvt_app(cmd, receiver_fx, shutdown_fx)) return; // This thread is no longer needed.
+                        #endif
                         auto stdwrite = std::thread{ [&]{ writer(); } };
                         auto stderror = std::thread{ [&]{ errlog(); } };
 
@@ -4677,11 +5248,19 @@ namespace netxs::os
             twod                    termsize{};
             flag                    attached{};
             flag                    signaled{};
-            escx                    writebuf{};
+            escx                    writebuf{}; // vtty: Input block being filled.
+            std::deque<text>        writeque{}; // vtty: Sealed input blocks awaiting the writer.
+            std::vector<text>       writebin{}; // vtty: Spare blocks for reuse.
+            size_t                  writelen{}; // vtty: Bytes held in writeque.
             std::mutex              writemtx{};
             std::condition_variable writesyn{};
             sptr<consrv>            termlink{};
 
+            static constexpr auto writeblk = 65536_sz;   // vtty: Input block size.
+            static constexpr auto writeiov = 64_sz;      // vtty: Max blocks per gather write.
+            static constexpr auto writebins = 16_sz;     // vtty: Max spare blocks.
+            static constexpr auto writecap = 1048576_sz; // vtty: Queued bytes beyond which mouse motion reports are dropped.
+
             operator bool () { return attached; }
 
             void payoff(bool io_log)
@@ -4701,6 +5280,9 @@ namespace netxs::os
                 {
                     auto guard = std::lock_guard{ writemtx };
                     writebuf = {};
+                    writeque.clear();
+                    writebin.clear();
+                    writelen = 0;
                 }
                 // Deadlock with writemtx: Processes try to write to the terminal when closing. Deadlock when closing nvim.exe's vtm desktop window if writemtx owned here.
                 if (termlink) termlink->cleanup(io_log);
@@ -4733,26 +5315,73 @@ namespace netxs::os
                 }
                 attached.exchange(!errcode);
             }
+            void seal() // Move the filled block to the write queue (writemtx must be held).
+            {
+                if (writebuf.empty()) return;
+                writelen += writebuf.size();
+                writeque.emplace_back().swap(writebuf);
+                if (writebin.size())
+                {
+                    writebuf.swap(writebin.back());
+                    writebin.pop_back();
+                }
+            }
+            void append(view data) // Append data in block-sized chunks cut at UTF-8 boundaries (writemtx must be held).
+            {
+                while (data.size())
+                {
+                    if (writebuf.size() >= writeblk) seal();
+                    auto size = std::min(data.size(), writeblk - writebuf.size());
+                    while (size < data.size() && (data[size] & 0xC0) == 0x80) size++; // Blocks are converted to UTF-16 one by one on Windows.
+                    writebuf += data.substr(0, size);
+                    data.remove_prefix(size);
+                }
+            }
+            auto queued() // Bytes waiting to be written to the pty.
+            {
+                auto guard = std::lock_guard{ writemtx };
+                return writelen + writebuf.size();
+            }
             void writer(auto& terminal)
             {
                 auto guard = std::unique_lock{ writemtx };
-                auto cache = text{};
-                while ((void)writesyn.wait(guard, [&]{ return writebuf.size() || !attached; }), attached)
+                auto cache = std::vector<text>{};
+                auto parts = std::vector<view>{};
+                while ((void)writesyn.wait(guard, [&]{ return writeque.size() || writebuf.size() || !attached; }), attached)
                 {
-                    std::swap(cache, writebuf);
+                    seal();
+                    auto count = std::min(writeque.size(), writeiov);
+                    for (auto i = 0_sz; i < count; i++)
+                    {
+                        writelen -= writeque.front().size();
+                        cache.push_back(std::move(writeque.front()));
+                        writeque.pop_front();
+                    }
                     guard.unlock();
-                    if (terminal.io_log) log(prompt::cin, "\n\t", utf::replace_all(ansi::hi(utf::debase(cache)), "\n", ansi::pushsgr().nil().add("\n\t").popsgr()));
-                    if (termlink->send(cache))
+                    parts.clear();
+                    for (auto& block : cache)
                     {
-                        cache.clear();
+                        if (terminal.io_log) log(prompt::cin, "\n\t", utf::replace_all(ansi::hi(utf::debase(block)), "\n", ansi::pushsgr().nil().add("\n\t").popsgr()));
+                        parts.push_back(block);
                     }
-                    else
+                    auto sent = termlink->send(parts);
+                    guard.lock();
+                    for (auto& block : cache) // Recycle blocks.
                     {
+                        if (writebin.size() < writebins && block.capacity() <= writeblk * 2)
+                        {
+                            block.clear();
+                            writebin.push_back(std::move(block));
+                        }
+                    }
+                    cache.clear();
+                    if (!sent)
+                    {
+                        guard.unlock();
                         if (terminal.io_log) log(prompt::vtty, "Unexpected disconnection");
                         termlink->sighup(); //todo interrupt reading thread
                         break;
                     }
-                    guard.lock();
                 }
             }
             void runapp(auto& terminal, eccc cfg, fdrw fds = {})
@@ -4816,7 +5445,7 @@ namespace netxs::os
                     {
                         auto utf8 = gear.interpret(decckm);
                         auto guard = std::lock_guard{ writemtx };
-                        writebuf += utf8;
+                        append(utf8);
                         writesyn.notify_one();
                     }
                 }
@@ -4833,12 +5462,11 @@ namespace netxs::os
                         auto guard = std::lock_guard{ writemtx };
                         if (bpmode)
                         {
-                            writebuf.reserve(writebuf.size() + data.size() + ansi::paste_begin.size() + ansi::paste_end.size());
-                            writebuf += ansi::paste_begin;
-                            writebuf += data;
-                            writebuf += ansi::paste_end;
+                            append(ansi::paste_begin);
+                            append(data);
+                            append(ansi::paste_end);
                         }
-                        else writebuf += data;
+                        else append(data);
                         writesyn.notify_one();
                     }
                 }
@@ -4864,6 +5492,8 @@ namespace netxs::os
                         || (state & mode::bttn && (gear.m_sys.buttons != gear.m_sav.buttons || gear.m_sys.wheelsi)))
                         {
                             auto guard = std::lock_guard{ writemtx };
+                            auto motion = moved && gear.m_sys.buttons == gear.m_sav.buttons && !gear.m_sys.wheelsi;
+                            if (motion && writelen + writebuf.size() > writecap) return; // Drop motion reports while the application is not reading input.
                             if (encod == prot::sgr)
                             {
                                 if (pixel)
@@ -4899,11 +5529,11 @@ namespace netxs::os
                 auto guard = std::lock_guard{ writemtx };
                 if constexpr (LFtoCR) // Clipboard paste. The Return key should send a CR character.
                 {
-                    writebuf.reserve(writebuf.size() + data.size());
                     auto head = data.begin();
                     auto tail = data.end();
                     while (head != tail)
                     {
+                        if (writebuf.size() >= writeblk && (*head & 0xC0) != 0x80) seal(); // Don't split UTF-8 sequences.
                         auto c = *head++;
                              if (c == '\n') c = '\r'; // LF -> CR.
                         else if (c == '\r' && head != tail && *head == '\n') head++; // CRLF -> CR.
@@ -4912,7 +5542,7 @@ namespace netxs::os
                 }
                 else
                 {
-                    writebuf += data;
+                    append(data);
                 }
                 if (attached) writesyn.notify_one();
             }
@@ -123,10 +123,14 @@ namespace netxs::ui
             X(LineWrapMode         ) /* */ \
             X(LineAlignMode        ) /* */ \
             X(LogMode              ) /* */ \
+            X(Record               ) /* Raw output recording */ \
+            X(Replay               ) /* Raw output recording playback */ \
             X(AltbufMode           ) /* */ \
             X(ForwardKeys          ) /* */ \
             X(ClearScrollback      ) /* */ \
             X(ScrollbackSize       ) /* */ \
+            X(ScrollbackStats      ) /* Scrollback memory usage */ \
+            X(MemoryUsage          ) /* Terminal memory usage */ \
             X(SetBackground        ) /* */ \
             X(ResetAttributes      ) /* */ \
             X(ScrollbackPadding    ) /* */ \
@@ -231,6 +235,7 @@ namespace netxs::ui
             si32 def_length;
             si32 def_growdt;
             si32 def_growmx;
+            bool def_dedup;
             wrap def_wrpmod;
             si32 def_tablen;
             si32 def_margin;
@@ -246,6 +251,7 @@ namespace netxs::ui
             bool resetonkey;
             bool resetonout;
             bool def_io_log;
+            text def_record;
             bool allow_logs;
             span def_period;
             pals def_colors;
@@ -305,6 +311,7 @@ namespace netxs::ui
                 def_growdt = std::max(0, config.settings::take("/config/terminal/scrollback/growstep",       si32{ 0 }    ));
                 def_growmx = std::max(0, config.settings::take("/config/terminal/scrollback/growlimit",      si32{ 0 }    ));
                 recalc_buffer_metrics(def_length, def_growdt, def_growmx);
+                def_dedup  =             config.settings::take("/config/terminal/scrollback/dedup",           true);
                 def_wrpmod =             config.settings::take("/config/terminal/scrollback/wrap",            deco::defwrp == wrap::on) ? wrap::on : wrap::off;
                 resetonkey =             config.settings::take("/config/terminal/scrollback/reset/onkey",     true);
                 resetonout =             config.settings::take("/config/terminal/scrollback/reset/onoutput",  faux);
@@ -319,6 +326,7 @@ namespace netxs::ui
                 def_curclr =             config.settings::take("/config/cursor/color",                    cell{});
                 def_period =             config.settings::take("/config/cursor/blink",                    span{ skin::globals().blink_period });
                 def_io_log =             config.settings::take("/config/debug/logs",        faux);
+                def_record =             config.settings::take("/config/debug/record",      text{});
                 allow_logs =             true; // Disallowed for dtty.
                 def_atexit =             config.settings::take("/config/terminal/atexit",                     commands::atexit::smart, atexit_options);
                 def_fcolor =             config.settings::take("/config/terminal/colors/default/fgc",         argb{ whitelt });
@@ -3564,7 +3572,7 @@ namespace netxs::ui
             {
                 top, mid, end,
             };
-            using ring = generics::ring<std::vector<line>, true>;
+            using ring = generics::ring<generics::chunked<line>, true>;
             using indx = generics::ring<std::vector<index_item>>;
 
             struct buff : public ring
@@ -3888,6 +3896,8 @@ namespace netxs::ui
             grip dnend; // scroll_buf: Selection second grip inside the bottom margin.
             part place; // scroll_buf: Selection last active region.
             si32 shore; // scroll_buf: Left and right scrollbuffer additional indents.
+            cellpool share{}; // scroll_buf: Shared content of the lines that have left the working area.
+            id_t     dedup{}; // scroll_buf: The first line id not yet shared.
 
             static constexpr auto approx_threshold = si32{ 10000 }; //todo make it configurable
 
@@ -5731,10 +5741,60 @@ namespace netxs::ui
             {
                 parser::flush();
                 batch.clear();
+                dedup = 0; // Line ids restart from zero.
                 reset_scroll_region();
                 bufferbase::clear_all();
                 resize_history(owner.defcfg.def_length, owner.defcfg.def_growdt, owner.defcfg.def_growmx);
             }
+            // scroll_buf: Share the content of the lines that have left the working area with identical lines.
+            void share_finished()
+            {
+                if (index.size == 0) return;
+                auto upto = index.front().index; // The top working line may be only partially scrolled out.
+                auto from = std::max(dedup, batch.front().index);
+                if (from < upto)
+                {
+                    auto head = batch.iter_by_id(from);
+                    auto tail = head + (si32)(upto - from);
+                    while (head != tail)
+                    {
+                        auto& l = *head;
+                        if (!l.get_image_sixel()) share.share(l.cells);
+                        ++head;
+                    }
+                }
+                dedup = upto;
+            }
+            // scroll_buf: Return the line count, cell bytes as stored without sharing, cell bytes actually held, and the part of them held by the lines above the working area.
+            auto memory_stats()
+            {
+                auto count = (si64)batch.size;
+                auto plain = si64{};
+                auto owned = si64{};
+                auto spare = si64{};
+                auto upto = index.size ? index.front().index : batch.back().index;
+                for (auto& l : batch)
+                {
+                    auto bytes = l.cells.weight();
+                    plain += (si64)(l.cells.size() * sizeof(cell));
+                    owned += bytes;
+                    if (l.index < upto) spare += bytes;
+                }
+                return std::tuple{ count, plain, owned, spare };
+            }
+            // scroll_buf: Drop the oldest lines above the working area until the specified number of bytes is released. Return the number of released bytes.
+            auto trim_front(si64 bytes)
+            {
+                auto freed = si64{};
+                if (index.size == 0) return freed;
+                auto upto = index.front().index;
+                while (freed < bytes && batch.size > 1 && batch.front().index < upto)
+                {
+                    freed += batch.front().cells.weight();
+                    batch.pop_front();
+                }
+                return freed;
+            }
             // scroll_buf: Set scrollback limits.
             void resize_history(si32 new_size, si32 grow_by = 0, si32 grow_mx = 0)
             {
@@ -6230,6 +6290,7 @@ namespace netxs::ui
             void clear_scrollback() override
             {
                 batch.clear_but_current();
+                dedup = 0; // Line ids restart from zero.
                 resize_viewport(panel, true);
             }
             //text get_current_line() override
@@ -7777,7 +7838,7 @@ namespace netxs::ui
             }
             return param_count;
         }
-        static text rgba_to_svg(std::vector<argb>& pixels, rect& area, bool implicit_size, argb transparent_pixel, bool transparent)
+        static void rgba_trim(std::vector<argb>& pixels, rect& area, bool implicit_size, argb transparent_pixel)
         {
             if (implicit_size || transparent_pixel == argb{}) // Trim transparent borders (get minimal non transparent area).
             {
@@ -7802,6 +7863,9 @@ namespace netxs::ui
                 netxs::onrect(raster, rect{ dot_00, dot_33 }, [](auto& p){ p = argb{ tint::purered }; });
                 netxs::onrect(raster, rect{ area.size - dot_33, dot_33 }, [](auto& p){ p = argb{ tint::pureblue }; });
             }
+        }
+        static text rgba_to_svg(std::vector<argb>& pixels, rect area, bool transparent)
+        {
             auto file_data = std::vector<byte>{};
             file_data.reserve(pixels.size());
             auto append_fx = [](void* context, void* data, si32 len)
@@ -7879,25 +7943,75 @@ namespace netxs::ui
                 return svg;
             }
         }
+        struct clipin_t
+        {
+            utf::unbase64_t decoder; // clipin_t: Incremental base64 decoder.
+            input::clipdata data;    // clipin_t: Decoded clipboard data.
+            bool            active{}; // clipin_t: The payload is still streaming in.
+        };
         struct sixel_t
         {
             static constexpr auto def_image_limits = twod{ 4096, 4096 };
             static constexpr auto def_palette_size = 2048;
             static constexpr auto max_palette_size = 65536;
+            static constexpr auto param_chars = "0123456789;"sv;
 
             term&             owner;
             std::vector<argb> bitmap; // Sixel bitmap buffer.
             std::vector<argb> palette = std::vector<argb>(sixel_t::def_palette_size); // Sixel palette.
             twod              cur_image_limits = def_image_limits;
+            text              carry; // Incomplete command at the end of the previous data chunk.
+            bool              active{}; // The image is being received.
+            twod              size; // Image size.
+            bool              implicit_size{}; // The raster attributes are not specified.
+            si32              aspect_ratio{}; // Pixel aspect ratio.
+            si32              transparent{}; // Keep zero sixels intact.
+            si32              stride{}; // Sixel line stride.
+            si32              cur_map{}; // Current color register.
+            argb              cur_fgc; // Current color.
+            argb              background_clr; // Zero sixels color.
+            si32              coor{}; // Current offset.
+            si32              maxx{}; // Current line limit.
+            si32              maxy{}; // Bitmap limit.
+            si32              line{}; // Current sixel line.
+            size_t            total{}; // Sixel data size.
+            span              busy{}; // Time spent decoding the image (excluding the waits for data).
+            time              shown{}; // The last image decoding end.
 
             void clear_state()
             {
                 palette.assign(sixel_t::def_palette_size, 0);
                 cur_image_limits = def_image_limits;
+                carry.clear();
+                active = faux;
+            }
+            // sixel: Print a run of identical sixels.
+            void print_sixels(si32 c, si32 count)
+            {
+                count = std::min(count, maxx - coor);
+                if (count <= 0) return;
+                auto offset = coor;
+                coor += count;
+                while (c)
+                {
+                    if (c & 1)
+                    {
+                        for (auto y = 0; y < aspect_ratio; y++)
+                        {
+                            if (offset < maxy) std::fill_n(bitmap.begin() + offset, count, cur_fgc); // The run never crosses the bitmap row.
+                            offset += size.x;
+                        }
+                    }
+                    else
+                    {
+                        offset += size.x * aspect_ratio;
+                    }
+                    c >>= 1;
+                }
             }
+            // sixel: Start a new image.
             void parse(qiew& q, auto& params)
             {
-                auto ok = faux;
                 // aspect_ratio:
                 // omitted     2:1
                 // 0 or 1      5:1
@@ -7907,69 +8021,88 @@ namespace netxs::ui
                 // 7,8, or 9   1:1
                 //                                        -1  0  1  2  3  4  5  6  7  8  9
                 static constexpr auto ar = std::to_array({ 2, 5, 5, 3, 2, 2, 2, 2, 1, 1, 1 });
-                auto aspect_ratio = ar[std::clamp(params[0] + 1, 0, (si32)ar.size() - 1)];
+                aspect_ratio = ar[std::clamp(params[0] + 1, 0, (si32)ar.size() - 1)];
                 // transparent:
                 // omitted     opaque  0's are filled with current background color
                 // 0 or 2      opaque
                 // 1           transparent   0's are kept intact
                 //                                        -1  0  1  2
                 static constexpr auto tr = std::to_array({ 0, 0, 1, 0 });
-                auto transparent = tr[std::clamp(params[1] + 1, 0, (si32)tr.size() - 1)];
+                transparent = tr[std::clamp(params[1] + 1, 0, (si32)tr.size() - 1)];
                 // hz_grid_size: We ignore it.
                 // n
                 //auto hz_grid_size = params[2];
-                auto size = owner.target->panel * ansi::cellsz;
-                auto implicit_size = true;
+                size = owner.target->panel * ansi::cellsz;
+                implicit_size = true;
                 //size.y *= aspect_ratio; // Don't scale max image size.
-                auto stride = size.x * aspect_ratio * 6;
-                auto cur_map = 0;
+                stride = size.x * aspect_ratio * 6;
+                cur_map = 0;
                 auto cur_clr = owner.target->get_effective_brush();
-                auto cur_fgc = cur_clr.fgc();
+                cur_fgc = cur_clr.fgc();
                 auto cur_bgc = cur_clr.bgc();
                 if (cur_clr.inv()) std::swap(cur_fgc, cur_bgc);
                 bitmap.clear();
-                auto coor = 0;
-                auto maxx = size.x;
-                auto maxy = size.x * size.y;
-                auto line = 0;
-                auto print_sixel = [&](si32 c)
-                {
-                    if (coor < maxx)
-                    {
-                        auto offset = coor++;
-                        while (c)
-                        {
-                            if (c & 1)
-                            {
-                                for (auto y = 0; y < aspect_ratio; y++)
-                                {
-                                    if (offset < maxy) bitmap[offset] = cur_fgc;
-                                    offset += size.x;
-                                }
-                            }
-                            else
-                            {
-                                offset += size.x * aspect_ratio;
-                            }
-                            c >>= 1;
-                        }
-                    }
-                };
-                auto background_clr = transparent ? argb{} : cur_bgc;
-                //auto hash = ui64{};
+                coor = 0;
+                maxx = size.x;
+                maxy = size.x * size.y;
+                line = 0;
+                background_clr = transparent ? argb{} : cur_bgc;
+                carry.clear();
+                active = true;
+                total = 0;
+                busy = {};
+                feed(q);
+            }
+            // sixel: Continue decoding the image with the next data chunk.
+            void feed(qiew& q)
+            {
+                while (carry.size() && q.size()) // Complete the command split across chunks.
+                {
+                    auto n = q.find_first_not_of(param_chars);
+                    auto take = n == text::npos ? q.size() : n + 1;
+                    carry += q.substr(0, take);
+                    q.remove_prefix(take);
+                    auto temp = std::move(carry);
+                    auto crop = qiew{ temp };
+                    carry.clear();
+                    decode(crop);
+                    if (!active) return;
+                }
+                if (q.size()) decode(q);
+            }
+            // sixel: Decode sixel data until ST. Returns the rest after ST.
+            void decode(qiew& q)
+            {
+                auto stamp = datetime::now();
+                total += q.size();
                 auto head = q.begin();
                 auto tail = q.end();
+                auto stash = [&](auto from) // Wait for the rest of the command.
+                {
+                    carry.assign(from, tail);
+                    total -= carry.size();
+                    head = tail;
+                };
+                auto params_end = [&] // Check that the command parameters are complete.
+                {
+                    auto iter = head;
+                    while (iter != tail && param_chars.find(*iter) != view::npos) iter++;
+                    return iter;
+                };
                 while (head != tail)
                 {
+                    auto from = head;
                     auto c = *head++;
                     if (c >= '?' && c <= '~') // Print sixels.
                     {
                         if (bitmap.empty()) [[unlikely]] { bitmap.assign(size.x * size.y, background_clr); }
                         c -= '?';
-                        print_sixel(c);
+                        if (c) print_sixels(c, 1);
+                        else if (coor < maxx) coor++;
                     }
                     else if (c == '!') // Repeat sixels.
                     {
+                        if (params_end() == tail) { stash(from); break; } // The repeated sixel is not received yet.
                         if (bitmap.empty()) [[unlikely]] { bitmap.assign(size.x * size.y, background_clr); }
                         auto q2 = qiew{ head, tail };
                         if (auto v = utf::to_int(q2))
@@ -7982,7 +8115,8 @@ namespace netxs::ui
                                     q2.pop_front();
                                     c2 -= '?';
                                     auto count = std::max(0, v.value());
-                                    while (count--) print_sixel(c2);
+                                    if (c2) print_sixels(c2, count);
+                                    else    coor = std::min(maxx, coor + std::min(count, maxx)); // Skip zero sixels.
                                 }
                             }
                         }
@@ -7991,6 +8125,7 @@ namespace netxs::ui
                     }
                     else if (c == '#') // Select register.
                     {
+                        if (params_end() == tail) { stash(from); break; }
                         auto q2 = qiew{ head, tail };
                         auto v = utf::to_int(q2);
                         cur_map = v ? std::clamp(v.value(), 0, (si32)palette.size() - 1) : 0;
@@ -8022,6 +8157,7 @@ namespace netxs::ui
                     }
                     else if (c == '"') // Raster Attributes (reset canvas).  "dy;dx;width;height  aspect_ratio=round(dy/dx).
                     {
+                        if (params_end() == tail) { stash(from); break; }
                         auto params2 = std::to_array({ -1, -1, -1, -1 });
                         auto q2 = qiew{ head, tail };
                         term::read_params(q2, params2);
@@ -8050,12 +8186,21 @@ namespace netxs::ui
                     {
                         coor = line * stride;
                     }
-                    else if ((c == '\x1b' && head != tail && *head == '\\' && (head++, true)) || c == '\a') // ST
+                    else if (c == '\x1b' && head == tail) // ST may be split across chunks.
                     {
-                        //if constexpr (debugmode) log("sixel complete");
-                        ok = true;
+                        stash(from);
                         break;
                     }
+                    else if ((c == '\x1b' && *head == '\\' && (head++, true)) || c == '\a') // ST
+                    {
+                        //if constexpr (debugmode) log("sixel complete");
+                        active = faux;
+                        total -= tail - head;
+                        q = qiew{ head, tail };
+                        busy += datetime::now() - stamp;
+                        show();
+                        return;
+                    }
                     //else if (c == '\x1b') //todo Escape sequence inside sixels. ?Should we parse it?
                     //{
                     //    if constexpr (debugmode) log("escape sequence inside sixels");
@@ -8065,6 +8210,7 @@ namespace netxs::ui
                     else if (c == ansi::c0_can || c == ansi::c0_sub) // Abort.
                     {
                         if constexpr (debugmode) log("sixel aborted");
+                        active = faux;
                         break;
                     }
                     else
@@ -8073,87 +8219,93 @@ namespace netxs::ui
                     }
                 }
                 q = qiew{ head, tail };
-                if (ok) // Show image.
-                {
-                    auto area = rect{ dot_00, size };
-                    auto doc_str = term::rgba_to_svg(bitmap, area, implicit_size, background_clr, transparent);
-                    auto fp_rc = fp2d{ area.coor } / fp2d{ ansi::cellsz }; // Position in cell grid.
-                    auto fp_wh = fp2d{ area.size } / fp2d{ ansi::cellsz }; // Size in cells.
-                    auto rc = twod{ std::floor(fp_rc) };
-                    auto fp_xy = fp_rc - rc; // Offset inside the cell grid.
-                    auto wh = twod{ std::ceil(fp_wh + fp_xy - 0.0001f/*compensate fp32 jitter*/) };
-                    auto gb_attr_x  = fp_xy.x;
-                    auto gb_attr_y  = fp_xy.y;
-                    auto gb_attr_w  = fp_wh.x;
-                    auto gb_attr_h  = fp_wh.y;
-                    auto gb_attr_u  = 0.f;
-                    auto gb_attr_v  = 0.f;
-                    auto gb_attr_uw = 1.f;
-                    auto gb_attr_vh = 1.f;
-                    auto images = cell::images(); // Lock.
-                    auto c = owner.target->cell_under_cursor(rc);
-                    if (auto index = c.get_image_index()) // Check the image id at the current cursor position.
-                    {
-                        auto prev_cr = c.get_image_cr();
-                        auto prev_WH = c.get_image_WH();
-                        if (prev_cr == dot_11 && prev_WH == wh) // Update existing image.
-                        {
-                            if (auto image_ptr = images.map[index])
-                            {
-                                auto& image = *image_ptr;
-                                image.reset_changes();
-                                image.check_and_set_document(doc_str);
-                                image.check_and_set_attr(imagens::gb::x , gb_attr_x);
-                                image.check_and_set_attr(imagens::gb::y , gb_attr_y);
-                                image.check_and_set_attr(imagens::gb::w , gb_attr_w);
-                                image.check_and_set_attr(imagens::gb::h , gb_attr_h);
-                                if (image.document_changed || image.changed_gb_attrs)
-                                {
-                                    image.stamp += 1;
-                                    owner.base::signal(tier::general, e2::data::image::update, index);
-                                }
-                                owner.print_sixel_image(image, rc, wh, transparent);
-                                return;
-                            }
-                            else
+                busy += datetime::now() - stamp;
+            }
+            // sixel: Place the decoded image.
+            void show()
+            {
+                if (owner.playing || owner.io_log) // Report the decoder throughput when benchmarking with replay.
+                {
+                    auto now = datetime::now();
+                    auto spent = std::max<si64>(1, datetime::round<si64, std::chrono::microseconds>(busy));
+                    auto cycle = shown != time{} ? now - shown : span{};
+                    shown = now;
+                    log("%%Sixel image %%: %% bytes decoded in %%us (%% MB/s), %% fps", prompt::term, size, total, spent, (si64)total / spent,
+                        cycle > span{} ? 1s / cycle : 0);
+                }
+                auto area = rect{ dot_00, size };
+                term::rgba_trim(bitmap, area, implicit_size, background_clr);
+                auto doc_str = skin::globals().raw_pixels ? imagens::pixmap::encode(bitmap, area.size) // Raw pixels as is.
+                                                          : term::rgba_to_svg(bitmap, area, transparent); // Compressed document.
+                auto fp_rc = fp2d{ area.coor } / fp2d{ ansi::cellsz }; // Position in cell grid.
+                auto fp_wh = fp2d{ area.size } / fp2d{ ansi::cellsz }; // Size in cells.
+                auto rc = twod{ std::floor(fp_rc) };
+                auto fp_xy = fp_rc - rc; // Offset inside the cell grid.
+                auto wh = twod{ std::ceil(fp_wh + fp_xy - 0.0001f/*compensate fp32 jitter*/) };
+                auto gb_attr_x  = fp_xy.x;
+                auto gb_attr_y  = fp_xy.y;
+                auto gb_attr_w  = fp_wh.x;
+                auto gb_attr_h  = fp_wh.y;
+                auto gb_attr_u  = 0.f;
+                auto gb_attr_v  = 0.f;
+                auto gb_attr_uw = 1.f;
+                auto gb_attr_vh = 1.f;
+                auto images = cell::images(); // Lock.
+                auto c = owner.target->cell_under_cursor(rc);
+                if (auto index = c.get_image_index()) // Check the image id at the current cursor position.
+                {
+                    auto prev_cr = c.get_image_cr();
+                    auto prev_WH = c.get_image_WH();
+                    if (prev_cr == dot_11 && prev_WH == wh) // Update existing image.
+                    {
+                        if (auto image_ptr = images.map[index])
+                        {
+                            auto& image = *image_ptr;
+                            image.reset_changes();
+                            image.check_and_set_document(doc_str);
+                            image.check_and_set_attr(imagens::gb::x , gb_attr_x);
+                            image.check_and_set_attr(imagens::gb::y , gb_attr_y);
+                            image.check_and_set_attr(imagens::gb::w , gb_attr_w);
+                            image.check_and_set_attr(imagens::gb::h , gb_attr_h);
+                            if (image.document_changed || image.changed_gb_attrs)
                             {
-                                if (owner.io_log) log("%%Broken image index: %%", prompt::term, index);
+                                image.stamp += 1;
+                                owner.base::signal(tier::general, e2::data::image::update, index);
                             }
+                            owner.print_sixel_image(image, rc, wh, transparent);
+                            return;
+                        }
+                        else
+                        {
+                            if (owner.io_log) log("%%Broken image index: %%", prompt::term, index);
                         }
                     }
-                    // Post a new image.
-                    //todo cache  auto iter = image_cache.find(doc_str); iter != image_cache.end();
-                    auto image_ptr = ptr::shared(imagens::image{ .document = doc_str });
-                    if (auto image_index = images.set(image_ptr))
-                    {
-                        auto& image = *image_ptr;
-                        image.id = "Sixel_"; // Set id="Sixel_FFFF".
-                        utf::to_hex(image_index, image.id);
-                        image.index = image_index;
-                        image.gb_attrs[imagens::gb::x  ] = gb_attr_x;
-                        image.gb_attrs[imagens::gb::y  ] = gb_attr_y;
-                        image.gb_attrs[imagens::gb::u  ] = gb_attr_u;
-                        image.gb_attrs[imagens::gb::v  ] = gb_attr_v;
-                        image.gb_attrs[imagens::gb::w  ] = gb_attr_w;
-                        image.gb_attrs[imagens::gb::h  ] = gb_attr_h;
-                        image.gb_attrs[imagens::gb::uw ] = gb_attr_uw;
-                        image.gb_attrs[imagens::gb::vh ] = gb_attr_vh;
-                        image.gb_attrs[imagens::gb::fit] = scale_mode::stretch;
-                        owner.image_sixel_count++;
-                        owner.print_sixel_image(image, rc, wh, transparent);
-                        // All sixel images will be removed on undock.
-                        //owner.sixel_cache[image.id] = image_ptr;
-                    }
-                    //todo sync original fragments
-                    //todo add a bitmap raster bit (introduce payload category: svg, raw, ...) to the imagens::image
-                    //todo store the payload in byts instead of text
-                    //todo implement own bitmap (raw category) rasterization (with interpolation)
-                    //todo hashing by sixel_string
                 }
-                else
+                // Post a new image.
+                //todo cache  auto iter = image_cache.find(doc_str); iter != image_cache.end();
+                auto image_ptr = ptr::shared(imagens::image{ .document = doc_str });
+                if (auto image_index = images.set(image_ptr))
                 {
-                    if constexpr (debugmode) log("sixel incomplete");
-                }
+                    auto& image = *image_ptr;
+                    image.id = "Sixel_"; // Set id="Sixel_FFFF".
+                    utf::to_hex(image_index, image.id);
+                    image.index = image_index;
+                    image.gb_attrs[imagens::gb::x  ] = gb_attr_x;
+                    image.gb_attrs[imagens::gb::y  ] = gb_attr_y;
+                    image.gb_attrs[imagens::gb::u  ] = gb_attr_u;
+                    image.gb_attrs[imagens::gb::v  ] = gb_attr_v;
+                    image.gb_attrs[imagens::gb::w  ] = gb_attr_w;
+                    image.gb_attrs[imagens::gb::h  ] = gb_attr_h;
+                    image.gb_attrs[imagens::gb::uw ] = gb_attr_uw;
+                    image.gb_attrs[imagens::gb::vh ] = gb_attr_vh;
+                    image.gb_attrs[imagens::gb::fit] = scale_mode::stretch;
+                    owner.image_sixel_count++;
+                    owner.print_sixel_image(image, rc, wh, transparent);
+                    // All sixel images will be removed on undock.
+                    //owner.sixel_cache[image.id] = image_ptr;
+                }
+                //todo sync original fragments
+                //todo hashing by sixel_string
             }
         };
 
@@ -8188,6 +8340,7 @@ namespace netxs::ui
         bool       io_log; // term: Stdio logging.
         bool       selalt; // term: Selection form (rectangular/linear).
         flag       resume; // term: Restart scheduled.
+        hook       ticker; // term: Viewport sync subscription (armed while out of sync).
         flag       forced; // term: Forced shutdown.
         si32       selmod; // term: Selection mode.
         si32       onesht; // term: Selection one-shot mode.
@@ -8212,6 +8365,14 @@ namespace netxs::ui
         ui16                                                  image_sixel_count{}; // term: Registered sixel image count;
         std::vector<ui16>                                     image_removed_indexes; // term: Image indexes to be deleted.
         sixel_t    sixels; // term: Sixel mode state.
+        clipin_t   clipin; // term: OSC 52 clipboard payload state.
+        os::io::vtrec       recorder; // term: Raw output recorder.
+        text                recfile;  // term: Raw output recording file path.
+        hook                playtick; // term: Recording playback timer subscription.
+        bool                playing{}; // term: Recorded output is being fed (don't re-record it).
+        netxs::sptr<ui::memory::item> memitem; // term: Process-wide memory accounting entry.
+        time                          memnext; // term: Next memory recount time.
+        hook                          memtick; // term: Deferred memory recount subscription.
         vtty       ipccon; // term: IPC connector. Should be destroyed first.
 
         // term: Print the block to the scrollback buffer with scroll.
@@ -8993,26 +9154,43 @@ namespace netxs::ui
             escbuf.add("\x1b[?", pi1, ';', ps_reply, ';', pv_reply, 'S');
             answer(escbuf);
         }
-        // term: Forward clipboard data (OSC 52).
+        // term: Forward clipboard data (OSC 52). An unterminated payload keeps streaming in through feed_clipboard().
         void forward_clipboard(view data)
         {
-            auto clipdata = input::clipdata{};
             auto delimpos = data.find(';');
             if (delimpos != text::npos)
             {
-                clipdata.meta = data.substr(0, delimpos++);
-                clipdata.utf8.clear();
-                utf::unbase64(data.substr(delimpos), clipdata.utf8);
-                clipdata.form = mime::disabled;
-                clipdata.size = target->panel;
-                clipdata.hash = datetime::now();
-                auto gates = base::riseup(tier::request, e2::form::state::keybd::enlist); // Take all foci.
-                for (auto gate_id : gates) // Signal them to set the clipboard data.
+                clipin.data.meta = data.substr(0, delimpos++);
+                clipin.data.utf8.clear();
+                clipin.decoder = {};
+                clipin.active = true;
+                auto q = qiew{ data.substr(delimpos) };
+                feed_clipboard(q);
+            }
+        }
+        // term: Decode the next chunk of the OSC 52 payload up to BEL or ST.
+        void feed_clipboard(qiew& q)
+        {
+            auto size = q.find_first_of("\x07\x1b"sv);
+            clipin.decoder.feed(q.substr(0, size), clipin.data.utf8);
+            if (size == view::npos)
+            {
+                q.remove_prefix(q.size());
+                return;
+            }
+            q.remove_prefix(q[size] == '\x07' ? size + 1 : size); // Leave ST (ESC \) to the parser.
+            clipin.decoder.flush(clipin.data.utf8);
+            clipin.active = faux;
+            auto clipdata = std::exchange(clipin.data, {});
+            clipdata.form = mime::disabled;
+            clipdata.size = target->panel;
+            clipdata.hash = datetime::now();
+            auto gates = base::riseup(tier::request, e2::form::state::keybd::enlist); // Take all foci.
+            for (auto gate_id : gates) // Signal them to set the clipboard data.
+            {
+                if (auto gear_ptr = base::getref<hids>(gate_id))
                 {
-                    if (auto gear_ptr = base::getref<hids>(gate_id))
-                    {
-                        gear_ptr->set_clipboard(clipdata);
-                    }
+                    gear_ptr->set_clipboard(clipdata);
                 }
             }
         }
@@ -9483,6 +9661,37 @@ namespace netxs::ui
                                    || (next_basis <= last_slide && last_slide <= last_basis);
                 }
             }
+            resync();
+        }
+        // term: Sync the viewport on the next frame tick (before world rendering).
+        void resync()
+        {
+            if (unsync && !ticker)
+            {
+                LISTEN(tier::general, e2::timer::tick, timestamp, ticker)
+                {
+                    ticker.reset(); // One-shot: let the timer thread sleep while the terminal is idle.
+                    if (unsync)
+                    {
+                        unsync = faux;
+                        auto& console = *target;
+                        auto scroll_size = console.panel;
+                        scroll_size.y += console.get_basis();
+                        auto scroll_coor = origin;
+                        scroll(scroll_coor);
+                        auto adjust_pads = console.recalc_pads(base::oversz);
+                        if (scroll_size != base::size() // Update scrollbars.
+                         || scroll_coor != origin
+                         || adjust_pads)
+                        {
+                            auto new_area = rect{ scroll_coor, scroll_size };
+                            base::signal(tier::release, e2::area, new_area);
+                            base::region = new_area;
+                        }
+                        base::deface();
+                    }
+                };
+            }
         }
         // term: Proceed terminal input.
         template<bool Forced = faux>
@@ -9492,7 +9701,20 @@ namespace netxs::ui
             if (data.size())
             {
                 if (io_log) log(prompt::cout, "\n\t", utf::replace_all(ansi::hi(utf::debase(data)), "\n", ansi::pushsgr().nil().add("\n\t").popsgr()));
+                if (recorder && !playing) recorder.write(data);
+                if (clipin.active) // Continue receiving the clipboard data (OSC 52).
+                {
+                    feed_clipboard(data);
+                    if (data.empty()) return true;
+                }
+                if (sixels.active) // Continue receiving the Sixel image.
+                {
+                    sixels.feed(data);
+                    if (data.empty()) return true;
+                }
                 ansi::parse(data, console_ptr);
+                if (defcfg.def_dedup) normal.share_finished();
+                memory_touch();
                 return true;
             }
             else
@@ -10000,6 +10222,116 @@ namespace netxs::ui
                 base::signal(tier::release, terminal::events::io_log, state);
             }
         }
+        // term: Start recording raw output to the file (empty path stops recording).
+        void set_record(text path)
+        {
+            recorder.close();
+            recfile.clear();
+            if (path.empty()) return;
+            if (recorder.open(path))
+            {
+                recfile = path;
+                log("%%Recording output to '%path%'", prompt::term, path);
+            }
+            else log("%%Failed to create recording file '%path%'", prompt::term, path);
+        }
+        // term: Play back the recording at the given speed (0: as fast as possible, in bounded slices per frame).
+        void replay(text path, fp64 speed)
+        {
+            static constexpr auto slice = 1048576_sz; // Max bytes fed per tick in the as-fast-as-possible mode.
+            playtick.reset();
+            auto player = ptr::shared<os::io::vtply>(path);
+            if (!*player)
+            {
+                log("%%Failed to open recording '%path%'", prompt::term, path);
+                return;
+            }
+            auto start = datetime::now();
+            LISTEN(tier::general, e2::timer::tick, timestamp, playtick, (player, speed, path, start, total = 0_sz, busy = span{}, chunk = player->next()))
+            {
+                auto played = (timestamp - start) * std::max(speed, 0.0);
+                auto budget = slice;
+                playing = true;
+                while (chunk.second.size() && (speed <= 0.0 ? budget : chunk.first <= played))
+                {
+                    auto stamp = datetime::now();
+                    ondata(chunk.second);
+                    busy += datetime::now() - stamp; // Count only the parsing time, not the gaps between frames.
+                    total += chunk.second.size();
+                    budget -= std::min(budget, chunk.second.size());
+                    chunk = player->next();
+                }
+                playing = faux;
+                if (chunk.second.empty())
+                {
+                    auto spent = std::max<si64>(1, datetime::round<si64, std::chrono::microseconds>(busy));
+                    log("%%Replayed '%path%': %% bytes parsed in %%us (%% MB/s)", prompt::term, path, total, spent, (si64)total / spent);
+                    playtick.reset();
+                }
+            };
+        }
+        // term: Return the number of heap bytes held by the terminal: total, scrollback, trimmable part of the scrollback, screen buffers, and images.
+        auto memory_usage()
+        {
+            auto [count, plain, owned, spare] = normal.memory_stats();
+            auto scrollback = owned + (si64)(normal.batch.ring::buff.capacity() * sizeof(line)
+                                           + normal.index.buff.capacity() * sizeof(scroll_buf::indx::type));
+            auto screens = (si64)((altbuf.canvas.pick().capacity()
+                                 + normal.upbox.pick().capacity()
+                                 + normal.dnbox.pick().capacity()) * sizeof(cell));
+            auto images = si64{};
+            {
+                auto cache = cell::images();
+                for (auto i = 1u; i < image_ref_count.size(); i++) // Sixels and inline images referenced by cells.
+                {
+                    if (image_ref_count[i] && cache.map[i]) images += (si64)cache.map[i]->document.size();
+                }
+                for (auto& [image_id, image_ptr] : image_cache) // Cached images that are not placed yet.
+                {
+                    if (image_ptr && !image_ref_count[image_ptr->index]) images += (si64)image_ptr->document.size();
+                }
+            }
+            return std::tuple{ scrollback + screens + images, scrollback, spare, screens, images };
+        }
+        // term: Recount the memory usage and check the memory budget if it has grown.
+        void memory_sync()
+        {
+            memnext = datetime::now() + 1s;
+            auto [total, scrollback, spare, screens, images] = memory_usage();
+            if (memitem->update(total, spare))
+            {
+                ui::memory::review(bell::indexer);
+            }
+            base::riseup(tier::preview, e2::config::memstat, total);
+        }
+        // term: Mark the terminal as active and recount its memory usage (at most once a second).
+        void memory_touch()
+        {
+            if (!memitem)
+            {
+                auto owner_wptr = base::weak_from_this();
+                if (owner_wptr.expired()) return; // Not attached yet.
+                memitem = ui::memory::attach(owner_wptr);
+            }
+            auto now = datetime::now();
+            memitem->stamp = now;
+            if (now >= memnext)
+            {
+                memtick.reset();
+                memory_sync();
+            }
+            else if (!memtick) // Recount after the output settles.
+            {
+                LISTEN(tier::general, e2::timer::tick, timestamp, memtick)
+                {
+                    if (timestamp >= memnext)
+                    {
+                        memtick.reset();
+                        memory_sync();
+                    }
+                };
+            }
+        }
         void clear_scrollback()
         {
             target->clear_scrollback();
@@ -10258,6 +10590,7 @@ namespace netxs::ui
                     //todo
                     break;
             }
+            resync();
         }
 
     protected:
@@ -10347,6 +10680,11 @@ namespace netxs::ui
             set_bg_color(defcfg.def_bcolor);
             selection_submit();
             selection_selmod(defcfg.def_selmod);
+            if (defcfg.def_record.size())
+            {
+                auto name = utf::concat("vtm-", os::process::id.first, "-", base::id, ".vtrec");
+                set_record((os::fs::path{ defcfg.def_record } / name).string());
+            }
 
             auto& mouse = base::plugin<pro::mouse>();
             mouse.draggable<hids::buttons::left>(selection_passed());
@@ -10674,6 +11012,29 @@ namespace netxs::ui
                                                             luafx.set_return();
                                                         }
                                                     }},
+                { methods::Record,                  [&]
+                                                    {
+                                                        luafx.run_with_gear_wo_return([&](auto& gear){ gear.set_handled(); });
+                                                        auto args_count = luafx.args_count();
+                                                        if (!args_count)
+                                                        {
+                                                            luafx.set_return(recfile);
+                                                        }
+                                                        else
+                                                        {
+                                                            auto path = luafx.get_args_or(1, ""s);
+                                                            set_record(path);
+                                                            luafx.set_return();
+                                                        }
+                                                    }},
+                { methods::Replay,                  [&]
+                                                    {
+                                                        luafx.run_with_gear_wo_return([&](auto& gear){ gear.set_handled(); });
+                                                        auto path = luafx.get_args_or(1, ""s);
+                                                        auto speed = luafx.get_args_or(2, fp64{ 1.0 });
+                                                        if (path.size()) replay(path, speed);
+                                                        luafx.set_return();
+                                                    }},
                 { methods::AltbufMode,              [&]
                                                     {
                                                         auto args_count = luafx.args_count();
@@ -10724,6 +11085,16 @@ namespace netxs::ui
                                                             luafx.set_return();
                                                         }
                                                     }},
+                { methods::ScrollbackStats,         [&]
+                                                    {
+                                                        auto [count, plain, owned, spare] = normal.memory_stats();
+                                                        luafx.set_return(count, plain, owned, spare);
+                                                    }},
+                { methods::MemoryUsage,             [&]
+                                                    {
+                                                        auto [total, scrollback, spare, screens, images] = memory_usage();
+                                                        luafx.set_return(total, scrollback, screens, images);
+                                                    }},
                 { methods::SetBackground,           [&]
                                                     {
                                                         target->parser::flush();
@@ -10884,28 +11255,6 @@ namespace netxs::ui
                                                     }},
             });
 
-            LISTEN(tier::general, e2::timer::tick, timestamp) // Update before world rendering.
-            {
-                if (unsync)
-                {
-                    unsync = faux;
-                    auto& console = *target;
-                    auto scroll_size = console.panel;
-                    scroll_size.y += console.get_basis();
-                    auto scroll_coor = origin;
-                    scroll(scroll_coor);
-                    auto adjust_pads = console.recalc_pads(base::oversz);
-                    if (scroll_size != base::size() // Update scrollbars.
-                     || scroll_coor != origin
-                     || adjust_pads)
-                    {
-                        auto new_area = rect{ scroll_coor, scroll_size };
-                        base::signal(tier::release, e2::area, new_area);
-                        base::region = new_area;
-                    }
-                    base::deface();
-                }
-            };
             LISTEN(tier::release, ui::e2::command::request::inputfields, inputfield_request)
             {
                 auto& console = *target;
@@ -10939,6 +11288,14 @@ namespace netxs::ui
             {
                 key_event(gear);
             };
+            LISTEN(tier::release, e2::config::memtrim, bytes)
+            {
+                if (normal.trim_front(bytes))
+                {
+                    ondata<true>();
+                    memory_sync();
+                }
+            };
             auto& prev_image_removed_indexes_size = base::field(size_t{});
             LISTEN(tier::release, e2::render::any, parent_canvas)
             {
@@ -11083,6 +11440,7 @@ namespace netxs::ui
                 {
                     owner.base::enqueue([&](auto& /*boss*/)
                     {
+                        owner.sync_solid();
                         owner.base::deface();
                     });
                 }
@@ -11375,6 +11733,18 @@ namespace netxs::ui
                     owner.base::riseup(tier::preview, e2::form::prop::cwd, path);
                 });
             }
+            void handle(s11n::xs::memstat             lock)
+            {
+                owner.base::enqueue([&, stat = lock.thing](auto& /*boss*/)
+                {
+                    if (!owner.memitem) owner.memitem = ui::memory::attach(owner.base::weak_from_this());
+                    owner.memitem->stamp = datetime::now() - stat.idle;
+                    if (owner.memitem->update(stat.bytes, stat.spare))
+                    {
+                        ui::memory::review(owner.bell::indexer);
+                    }
+                });
+            }
             void handle(s11n::xs::gui_command         lock)
             {
                 owner.base::enqueue([&, gui_cmd = lock.thing](auto& /*boss*/)
@@ -11424,8 +11794,11 @@ namespace netxs::ui
         si32 opaque; // dtvt: Object transparency on d_n_d (no pro::cache).
         si32 nodata; // dtvt: Show splash "No signal".
         si32 digest; // dtvt: Bitmap's update serial number.
+        si32 checked; // dtvt: Bitmap's serial number the opacity was evaluated for.
+        bool& solid; // dtvt: The received canvas is fully opaque and covers the object area (see hall occlusion culling).
         face splash; // dtvt: "No signal" splash.
         page errmsg; // dtvt: Overlay error message.
+        netxs::sptr<ui::memory::item> memitem; // dtvt: Memory accounting entry of the hosted process.
         vtty ipccon; // dtvt: IPC connector. Should be destroyed first.
 
         // dtvt: Format error message overlay.
@@ -11572,6 +11945,21 @@ namespace netxs::ui
                 else splash.wipe(cell{}.link(parent_id).fgc(blacklt).bgc(blacklt).alpha(0x40));
             }
         }
+        // dtvt: Evaluate canvas opacity once per received frame.
+        void check_solid(core const& canvas)
+        {
+            if (checked != digest)
+            {
+                checked = digest;
+                solid = opaque == 0xFF && canvas.size() == base::size()
+                     && std::ranges::all_of(canvas, [](cell const& c){ return c.bga() == 0xFF; });
+            }
+        }
+        void sync_solid()
+        {
+            auto lock = stream.bitmap_dtvt.freeze();
+            check_solid(lock.thing.image);
+        }
         // dtvt: Render next frame.
         void fill(core& parent_canvas, core const& canvas)
         {
@@ -11604,7 +11992,9 @@ namespace netxs::ui
               active{ true },
               opaque{ 0xFF },
               nodata{      },
-              digest{ 1    }
+              digest{ 1    },
+              checked{     },
+              solid{ base::property("applet.solid", faux) }
         {
             auto& accesslock_gears = base::property("applet.accesslock_gears", e2::form::state::keybd::enlist.param());
             LISTEN(tier::release, input::events::device::mouse::any, gear)
@@ -11684,6 +12074,10 @@ namespace netxs::ui
             {
                 stream.cwd.send(*this, path);
             };
+            LISTEN(tier::release, e2::config::memtrim, bytes)
+            {
+                stream.memtrim.send(*this, bytes);
+            };
             LISTEN(tier::release, e2::area, new_area)
             {
                 //todo implement deform/inform (for incoming XTWINOPS/swarp)
@@ -11696,7 +12090,12 @@ namespace netxs::ui
             LISTEN(tier::anycast, e2::form::prop::lucidity, value)
             {
                 if (value == -1) value = opaque;
-                else             opaque = value;
+                else
+                {
+                    opaque = value;
+                    checked = 0; // Reevaluate opacity.
+                    solid = faux;
+                }
             };
             static const auto calc_maxoff = [](auto fps) // Max delay before showing "No signal".
             {
@@ -11720,11 +12119,13 @@ namespace netxs::ui
                 auto& canvas = lock.thing.image;
                 if (nodata == canvas.hash()) // " No signal " on timeout > 1/60s
                 {
+                    solid = faux;
                     fallback(canvas);
                     fill(parent_canvas, splash);
                 }
                 else if (size == canvas.size())
                 {
+                    check_solid(canvas);
                     fill(parent_canvas, canvas);
                 }
                 else if (canvas.size())
@@ -11737,6 +12138,7 @@ namespace netxs::ui
                          && size != canvas.size())
                         {
                             nodata = canvas.hash();
+                            solid = faux;
                             fallback(canvas, faux, faux);
                             fill(parent_canvas, splash);
                             stream.waits = faux;
@@ -11744,6 +12146,7 @@ namespace netxs::ui
                         }
                     }
                     stream.waits = faux;
+                    check_solid(canvas);
                     fill(parent_canvas, canvas);
                 }
             };
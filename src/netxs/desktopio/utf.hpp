@@ -1186,6 +1186,8 @@ namespace netxs::utf
 
     template<class Key = text, class Val = text>
     using unordered_map = std::unordered_map<Key, Val, qiew::hash, qiew::equal>;
+    template<class Key = text>
+    using unordered_set = std::unordered_set<Key, qiew::hash, qiew::equal>;
 
     template<class A = si32, si32 Base = 10, class View, class = std::enable_if_t<std::is_base_of_v<view, View>>>
     std::optional<A> to_int(View& utf8)
@@ -1958,6 +1960,13 @@ namespace netxs::utf
         (s << ... << std::forward<Args>(args));
         return s.str();
     }
+    static constexpr auto base64look = [] // Base64 digit values, 0xFF for non-digits.
+    {
+        auto look = std::array<byte, 256>{};
+        look.fill(0xFF);
+        for (auto i = 0; i < 64; i++) look[(byte)base64code[i]] = (byte)i;
+        return look;
+    }();
     auto base64(view utf8)
     {
         auto code = base64code;
@@ -1965,85 +1974,100 @@ namespace netxs::utf
         if (auto size = utf8.size())
         {
             data.resize(((size + 2) / 3) << 2);
-            auto iter = utf8.begin();
-            auto tail = utf8.end();
-            auto dest = data.begin();
-            do
+            auto rest = size % 3;
+            auto iter = (byte const*)utf8.data();
+            auto tail = iter + size - rest;
+            auto dest = data.data();
+            while (iter != tail) // Whole triplets.
             {
-                auto crop = (byte)*iter++ << 16;
-                if (iter != tail) //todo move ifs to the outside of loop (optimization)
-                {
-                    crop += (byte)*iter++ << 8;
-                }
-                else
-                {
-                    *dest++ = code[0x3F & crop >> 18];
-                    *dest++ = code[0x3F & crop >> 12];
-                    *dest++ = '=';
-                    *dest++ = '=';
-                    break;
-                }
-                if (iter != tail)
-                {
-                    crop += (byte)*iter++;
-                }
-                else
-                {
-                    *dest++ = code[0x3F & crop >> 18];
-                    *dest++ = code[0x3F & crop >> 12];
-                    *dest++ = code[0x3F & crop >>  6];
-                    *dest++ = '=';
-                    break;
-                }
-                *dest++ = code[0x3F & crop >> 18];
-                *dest++ = code[0x3F & crop >> 12];
-                *dest++ = code[0x3F & crop >>  6];
-                *dest++ = code[0x3F & crop      ];
+                auto crop = (ui32)iter[0] << 16 | (ui32)iter[1] << 8 | (ui32)iter[2];
+                dest[0] = code[0x3F & crop >> 18];
+                dest[1] = code[0x3F & crop >> 12];
+                dest[2] = code[0x3F & crop >>  6];
+                dest[3] = code[0x3F & crop      ];
+                iter += 3;
+                dest += 4;
+            }
+            if (rest)
+            {
+                auto crop = (ui32)iter[0] << 16 | (rest == 2 ? (ui32)iter[1] << 8 : 0u);
+                dest[0] = code[0x3F & crop >> 18];
+                dest[1] = code[0x3F & crop >> 12];
+                dest[2] = rest == 2 ? code[0x3F & crop >> 6] : '=';
+                dest[3] = '=';
             }
-            while (iter != tail);
         }
         return data;
     }
-    auto unbase64(view bs64, text& data)
+    // utf: Incremental base64 decoder. Appends decoded bytes directly to the destination and stops at the first non-base64 char.
+    struct unbase64_t
     {
-        auto code = base64code;
-        auto is64 = [](auto c){ return (c > 0x2E && c < 0x3A) // '/' and digits
-                                    || (c > 0x40 && c < 0x5B) // Uppercase letters
-                                    || (c > 0x60 && c < 0x7B) // Lowercase letters
-                                    || (c == 0x2B); };        // '+'
-        auto look = view{ code };
-        //todo reserv data
-        if (auto size = bs64.size())
-        {
-            byte buff[4];
-            auto head = bs64.begin();
-            auto tail = head + size;
-            auto step = 0;
+        ui32 bits{}; // unbase64_t: Pending sextets.
+        si32 step{}; // unbase64_t: Pending sextet count.
+        bool done{}; // unbase64_t: Padding or a non-base64 char reached.
+
+        void feed(view bs64, text& data)
+        {
+            if (done || bs64.empty()) return;
+            auto& look = base64look;
+            auto head = (byte const*)bs64.data();
+            auto tail = head + bs64.size();
+            auto base = data.size();
+            data.resize(base + (step + bs64.size()) / 4 * 3); // Upper bound.
+            auto dest = (byte*)data.data() + base;
             while (head != tail)
             {
-                auto c = *head++;
-                if (!is64(c) || c == '=') break;
-
-                buff[step] = c;
+                if (step == 0)
+                {
+                    while (tail - head >= 4) // Whole quartets.
+                    {
+                        auto a = look[head[0]];
+                        auto b = look[head[1]];
+                        auto c = look[head[2]];
+                        auto d = look[head[3]];
+                        if ((a | b | c | d) & 0x80) break;
+                        auto crop = (ui32)a << 18 | (ui32)b << 12 | (ui32)c << 6 | (ui32)d;
+                        dest[0] = (byte)(crop >> 16);
+                        dest[1] = (byte)(crop >> 8);
+                        dest[2] = (byte)(crop);
+                        head += 4;
+                        dest += 3;
+                    }
+                    if (head == tail) break;
+                }
+                auto v = look[*head++];
+                if (v & 0x80)
+                {
+                    done = true;
+                    break;
+                }
+                bits = bits << 6 | v;
                 if (++step == 4)
                 {
+                    dest[0] = (byte)(bits >> 16);
+                    dest[1] = (byte)(bits >> 8);
+                    dest[2] = (byte)(bits);
+                    dest += 3;
+                    bits = 0;
                     step = 0;
-                    for (auto& a : buff) a = (byte)look.find(a);
-                    data.push_back(( buff[0]         << 2) + ((buff[1] & 0x30) >> 4));
-                    data.push_back(((buff[1] & 0x0F) << 4) + ((buff[2] & 0x3C) >> 2));
-                    data.push_back(((buff[2] & 0x03) << 6) +   buff[3]);
                 }
             }
-
-            if (step != 0)
-            {
-                auto temp = step;
-                while (temp < 4) buff[temp++] = 0;
-                for (auto& a : buff) a = (byte)look.find(a);
-                if (step > 1) data.push_back(( buff[0]         << 2) + ((buff[1] & 0x30) >> 4));
-                if (step > 2) data.push_back(((buff[1] & 0x0F) << 4) + ((buff[2] & 0x3C) >> 2));
-            }
+            data.resize(dest - (byte*)data.data());
         }
+        void flush(text& data) // Emit the trailing partial quartet.
+        {
+            if (step > 1) data.push_back((char)(bits << (6 * (4 - step)) >> 16));
+            if (step > 2) data.push_back((char)(bits << 6 >> 8));
+            bits = 0;
+            step = 0;
+            done = true;
+        }
+    };
+    auto unbase64(view bs64, text& data)
+    {
+        auto decoder = unbase64_t{};
+        decoder.feed(bs64, data);
+        decoder.flush(data);
     }
     auto unbase64(view bs64)
     {
@@ -35,12 +35,27 @@ namespace netxs
         using auth = netxs::events::auth;
         using context_t = std::vector<void*>;
 
+        struct stat_t
+        {
+            ui64 runs{}; // stat_t: Number of runs.
+            span total{}; // stat_t: Accumulated execution time.
+            span peak{}; // stat_t: Longest execution time.
+            text label; // stat_t: Script excerpt.
+        };
+
+        static constexpr auto cache_limit = 256; // luna: Max number of cached unreferenced functions.
+        static constexpr auto stats_limit = 1024; // luna: Max number of tracked scripts.
+
         auth&      indexer; // luna: .
         lua_State* lua; // luna: .
+        utf::unordered_map<text, si32>   shared; // luna: Reference counters of precompiled functions by script body.
+        std::deque<text>                 transient; // luna: Unreferenced cached functions in eviction order.
+        utf::unordered_map<text, stat_t> metrics; // luna: Script execution metrics by script body.
 
         static text vtmlua_torawstring(     lua_State* lua, si32 idx, bool extended = faux);
         static si32 vtmlua_object2string(   lua_State* lua);
         static si32 vtmlua_log(             lua_State* lua);
+        static si32 vtmlua_scriptstats(     lua_State* lua);
         static si32 vtmlua_call_method(     lua_State* lua);
         static si32 vtmlua_run_with_indexer(lua_State* lua, auto proc);
         static si32 vtmlua_terminal_index(  lua_State* lua);
@@ -67,7 +82,11 @@ namespace netxs
         text run_script(ui::base& object, view script_body, Arg&& param = {});
         void run_ext_script(ui::base& object, auto& script);
         si32 get_table_size();
+        void push_function_key(view script_body);
         bool push_function_id(view script_body);
+        bool push_function(view script_body, char const* chunk_name);
+        void trim_functions(si32 table_idx);
+        void account(view script_body, span elapsed);
         void precompile_function(sptr<std::pair<ui64, text>>& script_body_ptr);
         void remove_function(sptr<std::pair<ui64, text>>& script_body_ptr);
 
@@ -1356,6 +1375,7 @@ namespace netxs::xml
 
         suit page;
         sptr root_ptr;
+        ui64 generation{}; // document: Modification counter.
 
         document(document&&) = default;
         document(view utf8 = {}, view file = {})
@@ -1369,9 +1389,12 @@ namespace netxs::xml
         {
             page.swap(d.page);
             std::swap(root_ptr, d.root_ptr);
+            generation++;
+            d.generation++;
         }
         void load(view utf8, view file = {})
         {
+            generation++;
             page.init(file);
             parser{ root_ptr, page, utf8 };
         }
@@ -1565,6 +1588,7 @@ namespace netxs::xml
         }
         void combine_item(document& src_cfg)
         {
+            generation++;
             combine_item(src_cfg.page.frag_list, src_cfg.root_ptr);
         }
     };
@@ -1575,11 +1599,25 @@ namespace netxs::xml
         using sptr = xml::document::sptr;
         using list = std::list<xml::document::sptr>;
 
+        struct entry
+        {
+            sptr     item_ptr; // entry: Resolved element (null if not found).
+            text     value; // entry: Resolved element value.
+            std::any typed; // entry: Last parsed typed value.
+            vect     pins; // entry: Lookup context (keeps the context elements alive while cached).
+        };
+
         luna&            luafx; // settings: Lua sandbox.
         xml::document    document; // settings: XML document.
         vect             tmpbuff; // settings: Temp buffer.
         list             context; // settings: Current working context stack (reference context).
         std::deque<qiew> reference_path_array; // settings: Temp buffer for path segments.
+        utf::unordered_map<text, entry> compiled; // settings: Resolved values by lookup path and context.
+        ui64             compiled_gen{}; // settings: Document generation of the resolved values.
+        text             lookup_key; // settings: Temp buffer for the lookup key.
+        entry            scratch; // settings: Resolved value that cannot be cached.
+        si32             nesting{}; // settings: Value resolution depth.
+        bool             dynamic_value{}; // settings: The resolved value depends on Lua expressions.
 
         settings(luna& luafx)
             :  luafx{ luafx }
@@ -1756,6 +1794,7 @@ namespace netxs::xml
                     if (lua_expression)
                     {
                         reference_name.pop_front();
+                        dynamic_value = true;
                     }
                     if (!value_placeholder->busy)
                     {
@@ -1889,11 +1928,78 @@ namespace netxs::xml
             auto item_ptr = settings::take_ptr(subsection_ptr, attribute);
             return _take_value_from<Quiet>(item_ptr, attribute, defval);
         }
+        // settings: Resolve the value by path in the current context once per document generation.
+        entry& compile(qiew frompath)
+        {
+            if (compiled_gen != document.generation)
+            {
+                compiled.clear();
+                compiled_gen = document.generation;
+            }
+            lookup_key = frompath;
+            for (auto& ctx_ptr : context) // Relative paths and references are resolved against the whole context stack.
+            {
+                auto ctx_id = ctx_ptr.get();
+                lookup_key.push_back('\0');
+                lookup_key.append(reinterpret_cast<char const*>(&ctx_id), sizeof(ctx_id));
+            }
+            if (auto iter = compiled.find(lookup_key); iter != compiled.end())
+            {
+                return iter->second;
+            }
+            auto item_ptr = find_context_ptr(frompath);
+            auto value = text{};
+            dynamic_value = faux;
+            if (item_ptr)
+            {
+                nesting++;
+                value = settings::take_value(item_ptr);
+                nesting--;
+            }
+            auto& dest = dynamic_value ? scratch : compiled[lookup_key];
+            dest.item_ptr = item_ptr;
+            dest.value = std::move(value);
+            dest.typed.reset();
+            dest.pins.assign(context.begin(), context.end());
+            return dest;
+        }
         template<bool Quiet = true, class T = si32>
         auto take(qiew frompath, T defval = {})
         {
-            auto item_ptr = find_context_ptr(frompath);
-            return _take_value_from<Quiet>(item_ptr, frompath, defval);
+            if (nesting) // Lookups from inside the Lua expressions are not cached.
+            {
+                auto item_ptr = find_context_ptr(frompath);
+                return _take_value_from<Quiet>(item_ptr, frompath, defval);
+            }
+            auto& dest = settings::compile(frompath);
+            if (!dest.item_ptr)
+            {
+                if constexpr (!Quiet)
+                {
+                    log("%%%red% xml path not found: %nil%%path%", prompt::xml, ansi::fgc(redlt), ansi::nil(), frompath);
+                }
+                return defval;
+            }
+            if constexpr (std::is_same_v<std::decay_t<T>, text>)
+            {
+                return dest.value;
+            }
+            else
+            {
+                if (auto typed_ptr = std::any_cast<T>(&dest.typed))
+                {
+                    return *typed_ptr;
+                }
+                else if (auto result = xml::take<T>(dest.value))
+                {
+                    dest.typed = result.value();
+                    return result.value();
+                }
+                else
+                {
+                    return defval;
+                }
+            }
         }
         template<bool Quiet = true, class T>
         auto take_value_from(sptr subsection_ptr, view attribute, T defval, utf::unordered_map<text, T> const& dict)
@@ -445,7 +445,7 @@ int main(int argc, char* argv[])
                 auto cmd = script;
                 auto win = os::dtvt::gridsz;
                 auto gui = app::shared::get_gui_config(indexer.config);
-                userinit.send(client, userid.first, os::dtvt::vtmode, env, cwd, cmd, win);
+                userinit.send(client, userid.first, app::shared::get_vtmode(indexer.config), env, cwd, cmd, win);
                 app::shared::splice(client, gui);
                 return 0;
             }
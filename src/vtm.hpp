@@ -549,12 +549,34 @@ namespace netxs::app::vtm
         : public form<hall>
     {
     private:
+        // hall: Cut the hole out of the fragment list.
+        static void subtract(regs& frags, rect hole, regs& temp)
+        {
+            temp.clear();
+            for (auto& f : frags)
+            {
+                auto cut = f.trim(hole);
+                if (!cut)
+                {
+                    temp.push_back(f);
+                    continue;
+                }
+                auto f_apex = f.coor + f.size;
+                auto c_apex = cut.coor + cut.size;
+                if (cut.coor.y > f.coor.y) temp.push_back({ f.coor, { f.size.x, cut.coor.y - f.coor.y }});                   // Top.
+                if (c_apex.y < f_apex.y)   temp.push_back({{ f.coor.x, c_apex.y }, { f.size.x, f_apex.y - c_apex.y }});     // Bottom.
+                if (cut.coor.x > f.coor.x) temp.push_back({{ f.coor.x, cut.coor.y }, { cut.coor.x - f.coor.x, cut.size.y }}); // Left.
+                if (c_apex.x < f_apex.x)   temp.push_back({{ c_apex.x, cut.coor.y }, { f_apex.x - c_apex.x, cut.size.y }}); // Right.
+            }
+            std::swap(frags, temp);
+        }
         // hall: Desktop window.
         struct window_t : ui::form<window_t>
         {
             hall& world;
             si32& zorder;
             decltype(e2::form::state::keybd::enlist)::type& accesslock_gears;
+            bool& solid; // window: The applet content is fully opaque (reported by the applet).
             subs accesslock_token;
             bool highlighted = faux;
             bool active = faux;
@@ -635,7 +657,8 @@ namespace netxs::app::vtm
             window_t(hall& owner, applink& what)
                 : world{ owner },
                             zorder{ what.applet->base::property("applet.zorder", zpos::plain) },
-                  accesslock_gears{ what.applet->base::property("applet.accesslock_gears", e2::form::state::keybd::enlist.param()) }
+                  accesslock_gears{ what.applet->base::property("applet.accesslock_gears", e2::form::state::keybd::enlist.param()) },
+                  solid{ what.applet->base::property("applet.solid", faux) }
             {
                 base::plugin<pro::mouse>();
                 base::plugin<pro::d_n_d>();
@@ -643,6 +666,37 @@ namespace netxs::app::vtm
                 auto& title = base::plugin<pro::title>(what.applet->base::property("applet.header"), what.applet->base::property("applet.footer"));
                 base::plugin<pro::sizer>();
                 base::plugin<pro::frame>();
+                // Render the window body once per change and let every user gate composite the retained copy.
+                // Registered ahead of pro::light so that the highlight goes into the retained copy as well.
+                // Shadows, titles and sizers are drawn on postrender and stay per gate.
+                auto& surface = base::field<face>(); // Retained window body.
+                auto& shared = base::field(faux); // The retained copy is up to date.
+                auto& inside = base::field(faux); // Rendering into the retained copy.
+                surface.link(bell::id);
+                LISTEN(tier::release, e2::render::background::prerender, parent_canvas)
+                {
+                    if (inside) return;
+                    if (world.users.size() < 2) // Render directly when there is only one viewer.
+                    {
+                        shared = faux;
+                        return;
+                    }
+                    if (!shared || base::ruined() || surface.size() != base::size())
+                    {
+                        shared = true;
+                        inside = true;
+                        if (surface.size() != base::size()) surface.size(base::size());
+                        surface.wipe();
+                        base::ruined(faux);
+                        base::signal(tier::release, e2::render::background::prerender, surface);
+                        inside = faux;
+                    }
+                    auto full = parent_canvas.full();
+                    surface.move(full.coor);
+                    parent_canvas.fill(surface, cell::shaders::overlay);
+                    surface.move(dot_00);
+                    bell::expire();
+                };
                 base::plugin<pro::light>();
                 base::plugin<pro::focus>();
                 base::plugin<pro::keybd>();
@@ -1005,6 +1059,9 @@ namespace netxs::app::vtm
         pro::maker& maker; // hall: Window creator using drag and drop (right drag).
         pro::robot& robot; // hall: Animation controller.
         std::map<si32, ui::page> hall_overlays; // hall: User defined overlays (for Lua scripting output).
+        std::vector<rect> vacated; // hall: Areas of the windows closed since the last frames (their ids may still be in the gate id maps).
+        size_t settled{}; // hall: Number of vacated areas that have outlived one frame.
+        hook ticker; // hall: Frame tick subscription (kept only while users are connected).
 
         netxs::ui::sptr app_model_ptr = ptr::shared<ui::base>(ui::tui_domain());
         netxs::sptr<desk::usrs> usrs_list_ptr = ptr::shared<desk::usrs>();
@@ -1278,6 +1335,7 @@ namespace netxs::app::vtm
             });
             auto& config = bell::indexer.config;
             app::shared::get_tui_config(config, ui::skin::globals());
+            ui::memory::budget(config.settings::take("/config/desktop/membudget", si64{ 0 }) * 1024 * 1024);
 
             base::plugin<pro::focus>(pro::focus::mode::focusable);
             base::plugin<pro::keybd>();
@@ -1324,6 +1382,11 @@ namespace netxs::app::vtm
                                             base::cleanup(show_details);
                                             luafx.set_return();
                                         }},
+                { "MemoryUsage",        [&]
+                                        {
+                                            auto [bytes, spare, stamp] = ui::memory::total();
+                                            luafx.set_return(bytes, spare, ui::memory::budget());
+                                        }},
                 { "EventList",          [&]
                                             {
                                                 log("Registered events:");
@@ -1622,6 +1685,7 @@ namespace netxs::app::vtm
             LISTEN(tier::release, desk::events::apps::removed, window_ptr)
             {
                 auto& window = *window_ptr;
+                if (!window.base::hidden) vacated.push_back(window.base::area()); // Route events addressed to its stale ids to the uncovered window until the gates redraw.
                 if (base::subset.size()) // Pass focus to the top most object.
                 {
                     auto last_ptr = base::subset.back();
@@ -1884,15 +1948,22 @@ namespace netxs::app::vtm
                     gear_id = {};
                 }
             };
-            LISTEN(tier::general, e2::timer::any, timestamp)
+            LISTEN(tier::request, e2::form::layout::hittest, probe) // The probe id is stale: it is taken from the last rendered gate id map.
             {
-                if (base::ruined()) // Force all gates to redraw.
+                probe.id = {};
+                if (std::ranges::none_of(vacated, [&](auto& area){ return area.hittest(probe.coor); })) return; // The stale id belongs to a live window: drop the event.
+                for (auto layer : { zpos::topmost, zpos::plain, zpos::backmost }) // Find the window uncovered by the closed one.
                 {
-                    for (auto usergate_ptr : usrs_list)
+                    for (auto& item_ptr : base::subset | std::views::reverse)
                     {
-                        usergate_ptr->base::ruined(true);
+                        auto& window = *std::static_pointer_cast<window_t>(item_ptr);
+                        auto zorder = window.zorder == zpos::plain || window.zorder == zpos::topmost ? window.zorder : zpos::backmost;
+                        if (zorder == layer && !window.base::hidden && window.base::area().hittest(probe.coor))
+                        {
+                            probe.id = window.id;
+                            return;
+                        }
                     }
-                    base::ruined(faux);
                 }
             };
             LISTEN(tier::release, e2::render::background::prerender, parent_canvas) // Sync the hall basis with the current gate.
@@ -1903,6 +1974,9 @@ namespace netxs::app::vtm
                 }
             };
             auto& layers = base::field<std::array<std::vector<sptr>, 3>>();
+            auto& visible = base::field<std::vector<std::pair<sptr, rect>>>(); // Windows to draw with their clipping rects (top to bottom).
+            auto& covered = base::field<regs>(); // Opaque window areas above the current one.
+            auto& pieces = base::field<std::array<regs, 2>>(); // Temp buffers for the visible window fragments.
             LISTEN(tier::release, e2::render::any, parent_canvas)
             {
                 auto clip = parent_canvas.clip();         // Draw world without clipping. Wolrd has no size.
@@ -1950,14 +2024,46 @@ namespace netxs::app::vtm
                         }
                     }
                     //todo implement access lock visualization?
-                    for (auto& layer : layers)
+                    // Cull windows outside the viewport or under opaque windows, going from the top down.
+                    static constexpr auto outset = dent{ 2, 2, 1, 1 }; // Window decorations (shadow, frame) outside the window area.
+                    static constexpr auto max_pieces = 64_sz; // Stop splitting and use the bounding box beyond this fragment count.
+                    auto viewport = parent_canvas.clip();
+                    for (auto& layer : layers | std::views::reverse)
                     {
-                        for (auto& item_ptr : layer)
+                        for (auto& item_ptr : layer | std::views::reverse)
                         {
-                            item_ptr->render<true>(parent_canvas);
+                            auto& window = *std::static_pointer_cast<window_t>(item_ptr);
+                            if (window.base::hidden) continue;
+                            auto region = window.base::area();
+                            auto outer = viewport.trim(region + outset);
+                            if (!outer) continue;
+                            auto& frags = pieces[0];
+                            auto& temp = pieces[1];
+                            frags.assign(1, outer);
+                            for (auto hole : covered)
+                            {
+                                if (frags.empty() || frags.size() > max_pieces) break;
+                                hall::subtract(frags, hole, temp);
+                            }
+                            if (frags.empty()) continue; // Completely covered.
+                            auto clip = frags.front();
+                            for (auto& r : frags) clip |= r;
+                            visible.emplace_back(item_ptr, clip);
+                            if (window.solid)
+                            {
+                                if (auto inner = viewport.trim(region)) covered.push_back(inner);
+                            }
                         }
                         layer.clear();
                     }
+                    for (auto& [item_ptr, clip] : visible | std::views::reverse)
+                    {
+                        parent_canvas.clip(clip);
+                        item_ptr->render<true>(parent_canvas);
+                    }
+                    parent_canvas.clip(viewport);
+                    visible.clear();
+                    covered.clear();
                 }
                 while (overlay_iter != hall_overlays.end()) // Draw foreground (index >= 0) overlays.
                 {
@@ -2046,6 +2152,30 @@ namespace netxs::app::vtm
         {
             async.run(process);
         }
+        // hall: Follow the frame tick only while someone is watching (let the timer thread sleep otherwise).
+        void sync_ticker()
+        {
+            if (usrs_list.empty()) ticker.reset();
+            else if (!ticker)
+            {
+                LISTEN(tier::general, e2::timer::any, timestamp, ticker)
+                {
+                    if (vacated.size()) // The gates have redrawn their id maps since these windows closed.
+                    {
+                        vacated.erase(vacated.begin(), vacated.begin() + settled);
+                        settled = vacated.size();
+                    }
+                    if (base::ruined()) // Force all gates to redraw.
+                    {
+                        for (auto usergate_ptr : usrs_list)
+                        {
+                            usergate_ptr->base::ruined(true);
+                        }
+                        base::ruined(faux);
+                    }
+                };
+            }
+        }
         // hall: Create a new user gate.
         auto invite(xipc client, view userid, si32 vtmode, auto& packet, si32 session_id)
         {
@@ -2057,6 +2187,7 @@ namespace netxs::app::vtm
             auto users_iter = std::prev(users.end());
             usrs_list.push_back(usergate_ptr);
             auto usrs_list_iter = std::prev(usrs_list.end());
+            sync_ticker();
             usergate.props.background_color.link(bell::id);
             base::signal(tier::release, desk::events::usrs, usrs_list_ptr);
 
@@ -2277,6 +2408,7 @@ namespace netxs::app::vtm
             selected_item = usergate_selected_item;
             usrs_list.erase(usrs_list_iter);
             users.erase(users_iter);
+            sync_ticker();
             base::signal(tier::release, desk::events::usrs, usrs_list_ptr);
         }
         // hall: Shutdown.